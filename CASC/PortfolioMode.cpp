@@ -23,6 +23,8 @@
 #include "Lib/Timer.hpp"
 #include "Lib/Sys/Multiprocessing.hpp"
 
+#include "Indexing/TermSharing.hpp"
+
 #include "Shell/Options.hpp"
 #include "Shell/Statistics.hpp"
 #include "Shell/UIHelper.hpp"
@@ -125,6 +127,10 @@ bool PortfolioMode::searchForProof()
     TheoryFinder(_prb->units(),property).search();
   }
 
+  // the term bank is shared with all the forked children, make sure
+  // they do not need to write into it to fill in lazily computed data
+  env.sharing->precomputeDistinctVars();
+
   // now all the cpu usage will be in children, we'll just be waiting for them
   Timer::setTimeLimitEnforcement(false);
 
@@ -479,7 +485,8 @@ void PortfolioMode::runSlice(Options& strategyOpt)
     env.endOutput();
   }
 
-  Saturation::ProvingHelper::runVampire(*_prb, opt);
+  // the slice exits right after the proof attempt, no need to tear it down
+  Saturation::ProvingHelper::runVampire(*_prb, opt, true);
 
   //set return value to zero if we were successful
   if (env.statistics->terminationReason == Statistics::REFUTATION ||
@@ -32,6 +32,7 @@
 
 #include "SAT/Preprocess.hpp"
 #include "SAT/MinisatInterfacingNewSimp.hpp"
+#include "SAT/ExternalSATSolver.hpp"
 #include "SAT/BufferedSolver.hpp"
 
 #include "Lib/Environment.hpp"
@@ -135,6 +136,8 @@ FiniteModelBuilder::FiniteModelBuilder(Problem& prb, const Options& opt)
     default:
       ASSERTION_VIOLATION;
   }
+  // only the contour encoding stays valid when the sizes grow
+  _incremental = _xmass && opt.fmbIncremental();
 }
 
 FiniteModelBuilder::~FiniteModelBuilder()
@@ -154,6 +157,122 @@ FiniteModelBuilder::~FiniteModelBuilder()
 bool FiniteModelBuilder::reset(){
   CALL("FiniteModelBuilder::reset");
 
+  static const unsigned VAR_MAX = MinisatInterfacingNewSimp::VAR_MAX;
+
+  if(_incremental && _solver && _nextActivationVar <= VAR_MAX){
+    bool fits = true;
+    for(unsigned i=0;i<_distinctSortSizes.size();i++){
+      if(_distinctSortSizes[i] > _distinctSortCapacities[i]){
+        fits = false;
+        break;
+      }
+    }
+    if(fits){
+      // The variables for the new sizes are already laid out, so we keep the solver
+      // with everything encoded so far and only switch off the symmetry constraints
+      // of the previous sizes
+      addSATClause(SATLiteral(_activationVar,0));
+      _activationVar = _nextActivationVar++;
+      _solver->ensureVarCount(_activationVar);
+
+      createSymmetryOrdering();
+      return true;
+    }
+  }
+
+  setCapacities(_incremental);
+  unsigned offsets = computeOffsets();
+  if(!offsets && _incremental){
+    // no room to grow, lay out the variables just for the current sizes
+    setCapacities(false);
+    offsets = computeOffsets();
+  }
+  if(!offsets){
+    return false;
+  }
+  // nothing is encoded in the new solver
+  _encodedSortSizes.init(_sortModelSizes.size(),0);
+  _encodedDistinctSortSizes.init(_distinctSortSizes.size(),0);
+
+  // Create a new SAT solver
+  if(!_opt.fmbExternalSatSolver().empty()){
+    _solver = new ExternalSATSolver(_opt.fmbExternalSatSolver(),_opt.fmbDimacsFile());
+  }
+  else{
+    try{
+      // variable elimination is off in the incremental mode, the clauses of larger sizes
+      // can mention any of the variables
+      _solver = new MinisatInterfacingNewSimp(_opt,true,!_incremental);
+    }catch(Minisat::OutOfMemoryException&){
+      MinisatInterfacingNewSimp::reportMinisatOutOfMemory();
+    }
+  }
+
+  /*
+  if(_opt.satSolver() != Options::SatSolver::MINISAT){
+    cout << "Warning: overriding sat solver for FMB, using minisat" << endl;
+  }
+  */
+/*
+  switch(_opt.satSolver()){
+#if VZ3
+    case Options::SatSolver::Z3:
+        ASSERTION_VIOLATION_REP("Do not use fmb with Z3");
+#endif
+    case Options::SatSolver::MINISAT:
+        try{
+          _solver = new MinisatInterfacingNewSimp(_opt,true);
+        }catch(Minisat::OutOfMemoryException&){
+          MinisatInterfacingNewSimp::reportMinisatOutOfMemory();
+        }
+      break;
+    default:
+      ASSERTION_VIOLATION_REP(_opt.satSolver());
+  }
+*/
+
+  // set the number of SAT variables, this could cause an exception
+  if(_incremental){
+    _activationVar = offsets;
+    _nextActivationVar = offsets+1;
+    _solver->ensureVarCount(_activationVar);
+  }
+  else{
+    _solver->ensureVarCount(offsets-1);
+  }
+
+  // needs to be redone for each size as we use this to pick the number of
+  // things to order and the constants to ground with 
+  createSymmetryOrdering();
+
+  return true;
+}
+
+void FiniteModelBuilder::setCapacities(bool withRoomToGrow)
+{
+  CALL("FiniteModelBuilder::setCapacities");
+
+  _distinctSortCapacities.ensure(_distinctSortSizes.size());
+  for(unsigned i=0;i<_distinctSortSizes.size();i++){
+    unsigned capacity = _distinctSortSizes[i];
+    if(withRoomToGrow){
+      // doubling keeps the number of rebuilds logarithmic in the final size
+      capacity = max(capacity,min(2*capacity,_distinctSortMaxs[i]));
+    }
+    _distinctSortCapacities[i] = capacity;
+  }
+  _sortCapacities.ensure(_sortModelSizes.size());
+  for(unsigned s=0;s<_sortModelSizes.size();s++){
+    _sortCapacities[s] = _distinctSortCapacities[_sortedSignature->parents[s]];
+  }
+}
+
+// Returns 0 if we failed to compute the offsets, this can happen if offsets overflow 2^32, possible for
+// large signatures and large models. If this a frequent problem then we can go to longs.
+unsigned FiniteModelBuilder::computeOffsets()
+{
+  CALL("FiniteModelBuilder::computeOffsets");
+
   // Construct the offsets for symbols
   // Each symbol requires size^n) variables where n is the number of spaces for grounding
   // For function symbols we have n=arity+1 as we have the return value
@@ -177,14 +296,14 @@ bool FiniteModelBuilder::reset(){
     DArray<unsigned> f_signature = _sortedSignature->functionSignatures[f];
     ASS(f_signature.size() == env.signature->functionArity(f)+1);
 
-    unsigned add = _sortModelSizes[f_signature[0]]; 
+    unsigned add = _sortCapacities[f_signature[0]]; 
     for(unsigned i=1;i<f_signature.size();i++){
-      add *= _sortModelSizes[f_signature[i]];
+      add *= _sortCapacities[f_signature[i]];
     }
 
     // Check that we do not overflow
     if(VAR_MAX - add < offsets){
-      return false;
+      return 0;
     }
     offsets += add;
   }
@@ -201,12 +320,12 @@ bool FiniteModelBuilder::reset(){
     ASS(p_signature.size()==env.signature->predicateArity(p));
     unsigned add=1;
     for(unsigned i=0;i<p_signature.size();i++){
-      add *= _sortModelSizes[p_signature[i]];
+      add *= _sortCapacities[p_signature[i]];
     }
 
     // Check for overflow
     if(VAR_MAX - add < offsets){
-      return false;
+      return 0;
     }
     offsets += add; 
   }
@@ -218,13 +337,13 @@ bool FiniteModelBuilder::reset(){
   if (_xmass) {
     marker_offsets.ensure(_distinctSortSizes.size());
     for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
-      unsigned add = _distinctSortSizes[i];
+      unsigned add = _distinctSortCapacities[i];
 
       marker_offsets[i] = offsets;
 
       // Check for overflow
       if(VAR_MAX - add < offsets){
-        return false;
+        return 0;
       }
 
       offsets += add;
@@ -236,7 +355,7 @@ bool FiniteModelBuilder::reset(){
 
     // Check for overflow
     if(VAR_MAX - add < offsets){
-      return false;
+      return 0;
     }
 
     offsets += add;
@@ -245,50 +364,13 @@ bool FiniteModelBuilder::reset(){
 
     // Check for overflow
     if(VAR_MAX - add < offsets){
-      return false;
+      return 0;
     }
 
     offsets += add;
   }
 
-  // Create a new SAT solver
-  try{
-    _solver = new MinisatInterfacingNewSimp(_opt,true);
-  }catch(Minisat::OutOfMemoryException&){
-    MinisatInterfacingNewSimp::reportMinisatOutOfMemory();
-  }
-
-  /*
-  if(_opt.satSolver() != Options::SatSolver::MINISAT){
-    cout << "Warning: overriding sat solver for FMB, using minisat" << endl;
-  }
-  */
-/*
-  switch(_opt.satSolver()){
-#if VZ3
-    case Options::SatSolver::Z3:
-        ASSERTION_VIOLATION_REP("Do not use fmb with Z3");
-#endif
-    case Options::SatSolver::MINISAT:
-        try{
-          _solver = new MinisatInterfacingNewSimp(_opt,true);
-        }catch(Minisat::OutOfMemoryException&){
-          MinisatInterfacingNewSimp::reportMinisatOutOfMemory();
-        }
-      break;
-    default:
-      ASSERTION_VIOLATION_REP(_opt.satSolver());
-  }
-*/
-
-  // set the number of SAT variables, this could cause an exception
-  _solver->ensureVarCount(offsets-1);
-
-  // needs to be redone for each size as we use this to pick the number of
-  // things to order and the constants to ground with 
-  createSymmetryOrdering();
-
-  return true;
+  return offsets;
 }
 
 // Compare function symbols by their usage in the problem
@@ -914,6 +996,8 @@ void FiniteModelBuilder::addGroundClauses()
 
   // If we don't have any ground clauses don't do anything
   if(!_groundClauses) return;
+  // They do not depend on the sizes, so they are added only once to the incremental solver
+  if(_encodedDistinctSortSizes.size() && _encodedDistinctSortSizes[0]) return;
 
   ClauseList::Iterator cit(_groundClauses);
 
@@ -963,6 +1047,26 @@ unsigned FiniteModelBuilder::estimateInstanceCount()
   return res;
 }
 
+/**
+ * A literal of a clause prepared for grounding in addNewInstances.
+ * The SAT variable of its instance is offset plus the sum of
+ * mult*(grounding[var]-1) over its arguments (see getSATLiteral).
+ */
+struct FMBGroundingLiteral
+{
+  unsigned offset;
+  bool polarity;
+  // arguments are stored in a shared stack from firstArg on
+  unsigned firstArg;
+  unsigned argCnt;
+};
+
+struct FMBGroundingArgument
+{
+  unsigned var;
+  unsigned mult;
+};
+
 void FiniteModelBuilder::addNewInstances()
 {
   CALL("FiniteModelBuilder::addNewInstances");
@@ -1012,6 +1116,52 @@ void FiniteModelBuilder::addNewInstances()
       }
     }
     
+    // Translate the literals only once per clause, the variable equalities
+    // x=y are kept aside as they are decided by the grounding itself
+    static Stack<FMBGroundingLiteral> glits;
+    static Stack<FMBGroundingArgument> gargs;
+    static Stack<Literal*> varEqualities;
+    glits.reset();
+    gargs.reset();
+    varEqualities.reset();
+    for(unsigned lindex=0;lindex<c->length();lindex++){
+      Literal* lit = (*c)[lindex];
+      if(lit->isTwoVarEquality()){
+        varEqualities.push(lit);
+        continue;
+      }
+      FMBGroundingLiteral glit;
+      glit.polarity = lit->polarity();
+      glit.firstArg = gargs.size();
+      Term* t;
+      const DArray<unsigned>* signature;
+      if(lit->isEquality()){
+        ASS(lit->nthArgument(0)->isTerm());
+        ASS(lit->nthArgument(1)->isVar());
+        // f(x1,...,xn)=y is grounded as the function value [x1,...,xn,y]
+        t = lit->nthArgument(0)->term();
+        glit.offset = f_offsets[t->functor()];
+        signature = &_sortedSignature->functionSignatures[t->functor()];
+      }else{
+        t = lit;
+        glit.offset = p_offsets[lit->functor()];
+        signature = &_sortedSignature->predicateSignatures[lit->functor()];
+      }
+      unsigned mult = 1;
+      for(unsigned j=0;j<t->arity();j++){
+        ASS(t->nthArgument(j)->isVar());
+        FMBGroundingArgument garg = { t->nthArgument(j)->var(), mult };
+        gargs.push(garg);
+        mult *= _sortCapacities[(*signature)[j]];
+      }
+      if(lit->isEquality()){
+        FMBGroundingArgument garg = { lit->nthArgument(1)->var(), mult };
+        gargs.push(garg);
+      }
+      glit.argCnt = gargs.size()-glit.firstArg;
+      glits.push(glit);
+    }
+
     static DArray<unsigned> grounding;
     grounding.ensure(vars);
 
@@ -1028,6 +1178,18 @@ instanceLabel:
       else{
         grounding[var]++;
         // Grounding represents a new instance
+        if(!isNewGrounding(grounding,*varSorts,vars)){
+          goto instanceLabel;
+        }
+        // a true x=y makes the instance a tautology, a false one is just dropped
+        for(unsigned k=0;k<varEqualities.size();k++){
+          Literal* lit = varEqualities[k];
+          bool equal = grounding[lit->nthArgument(0)->var()] == grounding[lit->nthArgument(1)->var()];
+          if(lit->isPositive() == equal){
+            //Skip instance
+            goto instanceLabel;
+          }
+        }
         static SATLiteralStack satClauseLits;
         satClauseLits.reset();
 
@@ -1074,49 +1236,13 @@ instanceLabel:
         }
 
         // Ground and translate each literal into a SATLiteral
-        for(unsigned lindex=0;lindex<c->length();lindex++){
-          Literal* lit = (*c)[lindex];
-
-          // check cases where literal is x=y
-          if(lit->isTwoVarEquality()){
-            bool equal = grounding[lit->nthArgument(0)->var()] == grounding[lit->nthArgument(1)->var()]; 
-            if((lit->isPositive() && equal) || (!lit->isPositive() && !equal)){
-              //Skip instance
-              goto instanceLabel; 
-            } 
-            if((lit->isPositive() && !equal) || (!lit->isPositive() && equal)){
-              //Skip literal
-              continue;
-            }
-          }
-          if(lit->isEquality()){
-            ASS(lit->nthArgument(0)->isTerm());
-            ASS(lit->nthArgument(1)->isVar());
-            Term* t = lit->nthArgument(0)->term();
-            unsigned functor = t->functor();
-            unsigned arity = t->arity();
-            static DArray<unsigned> use;
-            use.ensure(arity+1);
-
-            for(unsigned j=0;j<arity;j++){
-              ASS(t->nthArgument(j)->isVar());
-              use[j] = grounding[t->nthArgument(j)->var()];
-            }
-            use[arity]=grounding[lit->nthArgument(1)->var()];
-            satClauseLits.push(getSATLiteral(functor,use,lit->polarity(),true));
-            
-          }else{
-            unsigned functor = lit->functor();
-            unsigned arity = lit->arity();
-            static DArray<unsigned> use;
-            use.ensure(arity);
-
-            for(unsigned j=0;j<arity;j++){
-              ASS(lit->nthArgument(j)->isVar());
-              use[j] = grounding[lit->nthArgument(j)->var()];
-            }
-            satClauseLits.push(getSATLiteral(functor,use,lit->polarity(),false));
+        for(unsigned k=0;k<glits.size();k++){
+          const FMBGroundingLiteral& glit = glits[k];
+          unsigned satVar = glit.offset;
+          for(unsigned a=glit.firstArg;a<glit.firstArg+glit.argCnt;a++){
+            satVar += gargs[a].mult*(grounding[gargs[a].var]-1);
           }
+          satClauseLits.push(SATLiteral(satVar,glit.polarity));
         }
      
         SATClause* satCl = SATClause::fromStack(satClauseLits);
@@ -1211,6 +1337,16 @@ newFuncLabel:
             //Skip this instance
             goto newFuncLabel;
           }
+          // as y < z, the instance is new if z or one of the x's is new
+          if(grounding[1]<=_encodedSortSizes[returnSrt]){
+            bool isNew = false;
+            for(unsigned var=2;!isNew && var<arity+2;var++){
+              isNew = grounding[var] > _encodedSortSizes[f_signature[var-2]];
+            }
+            if(!isNew){
+              goto newFuncLabel;
+            }
+          }
           static SATLiteralStack satClauseLits;
           satClauseLits.reset();
 
@@ -1260,6 +1396,10 @@ void FiniteModelBuilder::addNewSymmetryOrderingAxioms(unsigned size,
     SATLiteral sl = getSATLiteral(gt.f,grounding,true,true);
     satClauseLits.push(sl);
   }
+  if(_incremental){
+    // only valid for the current sizes
+    satClauseLits.push(SATLiteral(_activationVar,0));
+  }
   SATClause* satCl = SATClause::fromStack(satClauseLits);
   addSATClause(satCl);
 
@@ -1306,6 +1446,10 @@ void FiniteModelBuilder::addNewSymmetryCanonicityAxioms(unsigned size,
 
         satClauseLits.push(getSATLiteral(gtj.f,grounding_j,true,true));
       }
+      if(_incremental){
+        // only valid for the current sizes
+        satClauseLits.push(SATLiteral(_activationVar,0));
+      }
       addSATClause(SATClause::fromStack(satClauseLits));
   }
 
@@ -1358,7 +1502,9 @@ void FiniteModelBuilder::addNewTotalityDefs()
     // make sure to solve the problem of some sorts not growing all the way to _sortModelSizes[srt], because of _sortedSignature->sortBounds[srt]
     for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
       // for every sort
-      for (unsigned j = 0; j < _distinctSortSizes[i]-1; j++) {
+      // the clauses up to the encoded size are already there
+      unsigned from = _encodedDistinctSortSizes[i] ? _encodedDistinctSortSizes[i]-1 : 0;
+      for (unsigned j = from; j < _distinctSortSizes[i]-1; j++) {
         // for every domain size j have clause: not marker(j+1) | marker(j)
         // which says: "d > j+2" -> "d > j+1"
         static SATLiteralStack satClauseLits;
@@ -1389,6 +1535,9 @@ void FiniteModelBuilder::addNewTotalityDefs()
       // cout << "Totality for const " << f << " of sort " << srt << " and max size " << maxSize << endl;
 
       for (unsigned i = (!_xmass || (_sortedSignature->monotonicSorts[dsrt])) ? maxSize : 1; i <= maxSize; i++) { // just the weakest one, if monotonic
+        if(isTotalityEncoded(srt,maxSize,i)){
+          continue;
+        }
         static SATLiteralStack satClauseLits;
         satClauseLits.reset();
 
@@ -1441,7 +1590,11 @@ newTotalLabel:
           //for(unsigned j=0;j<grounding.size();j++) cout << grounding[j] << " ";
           //cout << endl;
 
+          bool newGrounding = isNewGrounding(grounding,f_signature,arity);
           for (unsigned i = (!_xmass || (_sortedSignature->monotonicSorts[dRetSrt])) ? maxRtSrtSize : 1; i <= maxRtSrtSize; i++) {
+            if(!newGrounding && isTotalityEncoded(retSrt,maxRtSrtSize,i)){
+              continue;
+            }
             static SATLiteralStack satClauseLits;
             satClauseLits.reset();
 
@@ -1501,14 +1654,44 @@ SATLiteral FiniteModelBuilder::getSATLiteral(unsigned f, const DArray<unsigned>&
   for(unsigned i=0;i<grounding.size();i++){
     var += mult*(grounding[i]-1);
     unsigned srt = signature[i];
-    //cout << var << ", " << mult << "," << _sortModelSizes[srt] << endl;
-    mult *= _sortModelSizes[srt];
+    //cout << var << ", " << mult << "," << _sortCapacities[srt] << endl;
+    mult *= _sortCapacities[srt];
   }
   //cout << "return " << var << endl;
 
   return SATLiteral(var,polarity);
 }
 
+bool FiniteModelBuilder::isNewGrounding(const DArray<unsigned>& grounding,
+                                        const DArray<unsigned>& sorts, unsigned length)
+{
+  CALL("FiniteModelBuilder::isNewGrounding");
+
+  for(unsigned i=0;i<length;i++){
+    if(grounding[i] > _encodedSortSizes[sorts[i]]){
+      return true;
+    }
+  }
+  return false;
+}
+
+/*
+ * The version of size i is marked by i-1, except for the largest one (maxSize) which
+ * is marked by the largest marker of the distinct sort. So a version already encoded
+ * is still the same clause, unless it was and is the largest one and the marker moved.
+ */
+bool FiniteModelBuilder::isTotalityEncoded(unsigned srt, unsigned maxSize, unsigned i)
+{
+  CALL("FiniteModelBuilder::isTotalityEncoded");
+
+  unsigned encodedMaxSize = min(_sortedSignature->sortBounds[srt],_encodedSortSizes[srt]);
+  if(i > encodedMaxSize){
+    return false;
+  }
+  unsigned dsrt = _sortedSignature->parents[srt];
+  return i != maxSize || _encodedDistinctSortSizes[dsrt] == _distinctSortSizes[dsrt];
+}
+
 void FiniteModelBuilder::addSATClause(SATClause* cl)
 {
   CALL("FiniteModelBuilder::addSATClause");
@@ -1611,6 +1794,14 @@ MainLoopResult FiniteModelBuilder::runImpl()
 #endif
     addNewTotalityDefs();
 
+    if(_incremental){
+      for(unsigned s=0;s<_sortModelSizes.size();s++){
+        _encodedSortSizes[s] = _sortModelSizes[s];
+      }
+      for(unsigned i=0;i<_distinctSortSizes.size();i++){
+        _encodedDistinctSortSizes[i] = _distinctSortSizes[i];
+      }
+    }
     }
 
 #if VTRACE_FMB
@@ -1635,6 +1826,9 @@ MainLoopResult FiniteModelBuilder::runImpl()
           assumptions.push(SATLiteral(marker_offsets[i]+_distinctSortSizes[i]-1,0));
           // cout << "assuming sort " << i << " value " << _distinctSortSizes[i]-1 << " negative" << endl;
         }
+        if (_incremental) {
+          assumptions.push(SATLiteral(_activationVar,1));
+        }
       } else {
         for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
           assumptions.push(SATLiteral(totalityMarker_offset+i,1));
@@ -1653,6 +1847,13 @@ MainLoopResult FiniteModelBuilder::runImpl()
       onModelFound();
       return MainLoopResult(Statistics::SATISFIABLE);
     }
+    // only an external solver can fail to give an answer
+    if(satResult == SATSolver::UNKNOWN){
+      if(outputAllowed()) {
+        cout << "The SAT solver did not decide the problem" << endl;
+      }
+      goto gave_up;
+    }
 
     static unsigned numberOfSatCalls = 0;
     numberOfSatCalls++;
@@ -1681,6 +1882,11 @@ MainLoopResult FiniteModelBuilder::runImpl()
         for (unsigned i = 0; i < failed.size(); i++) {
           unsigned var = failed[i].var();
 
+          // the symmetry constraints do not tell which domain to grow
+          if (_incremental && var == _activationVar) {
+            continue;
+          }
+
           unsigned srt = which_sort(var);
 
           // cout << "which_sort(var) = " << srt << endl;
@@ -123,15 +123,34 @@ private:
 
   // resets all structures and SAT solver using _sortModelSizes 
   bool reset();
+  // sets the capacities of sorts, either to the current sizes or with room to grow
+  void setCapacities(bool withRoomToGrow);
+  // computes the offsets of symbols and markers from the capacities, returns the first unused variable
+  // or 0 if the variables cannot be represented
+  unsigned computeOffsets();
+
+  // true if some element of grounding exceeds the size already encoded for its sort
+  bool isNewGrounding(const DArray<unsigned>& grounding, const DArray<unsigned>& sorts, unsigned length);
+  // true if the totality clause of size i for a term of sort srt is already in the SAT solver
+  bool isTotalityEncoded(unsigned srt, unsigned maxSize, unsigned i);
 
   // make the symmetry orderings
   void createSymmetryOrdering();
   // The per-sort ordering of grounded terms used for symmetry breaking
   DArray<Stack<GroundedTerm>> _sortedGroundedTerms;
 
-  // SAT solver used to solve constraints (a new one is used for each model size)
+  // SAT solver used to solve constraints (a new one is used for each model size, unless _incremental)
   ScopedPtr<SATSolverWithAssumptions> _solver;
 
+  // keep _solver when the sizes grow and only add the constraints for the new groundings
+  // (only used with the contour encoding)
+  bool _incremental;
+  // In the incremental mode, the size dependent constraints (symmetry breaking) are guarded
+  // by _activationVar, which is assumed for the current sizes and disabled when they change.
+  // Fresh activation variables are taken from _nextActivationVar.
+  unsigned _activationVar;
+  unsigned _nextActivationVar;
+
   // Structures to record symbols removed during preprocessing i.e. via definition elimination
   // These are ignored throughout finite model building and then the definitions (recorded here)
   // are used to give the interpretation of the function/predicate if a model is found
@@ -178,7 +197,7 @@ private:
 
   // if (_xmass) {
 
-  /* Each distinctSort has as many markers as is its current size.
+  /* Each distinctSort has as many markers as is its capacity.
    * Their offsets are stored on per sort basis.
    */
   DArray<unsigned> marker_offsets;
@@ -228,6 +247,12 @@ private:
   // sizes to use for each sort
   DArray<unsigned> _sortModelSizes;
   DArray<unsigned> _distinctSortSizes;
+  // sizes for which the SAT variables are laid out, never smaller than the sizes above
+  DArray<unsigned> _sortCapacities;
+  DArray<unsigned> _distinctSortCapacities;
+  // sizes for which the constraints are already in the SAT solver (0 if there are none)
+  DArray<unsigned> _encodedSortSizes;
+  DArray<unsigned> _encodedDistinctSortSizes;
 
   enum ConstraintSign {
     EQ,     // the value has to matched
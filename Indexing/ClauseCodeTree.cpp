@@ -12,6 +12,7 @@
  * Implements class ClauseCodeTree.
  */
 
+#include <algorithm>
 #include <utility>
 
 #include "Debug/RuntimeStatistics.hpp"
@@ -241,6 +242,8 @@ void ClauseCodeTree::remove(Clause* cl)
   firstsInBlocks.reset();
   rlms.reset();
 
+  _entryCnt--;
+
   if(!clen) {
     CodeOp* op=getEntryPoint();
     firstsInBlocks.push(op);
@@ -308,6 +311,48 @@ void ClauseCodeTree::remove(Clause* cl)
   }
 }
 
+/**
+ * Remove all the clauses of @b cls. If they are numerous enough, the tree
+ * is traversed only once instead of looking up each clause by
+ * RemovingLiteralMatchers.
+ */
+void ClauseCodeTree::remove(Stack<Clause*>& cls)
+{
+  CALL("ClauseCodeTree::remove/batch");
+
+  if(!isSweepCheaper(cls.size())) {
+    Stack<Clause*>::Iterator cit(cls);
+    while(cit.hasNext()) {
+      remove(cit.next());
+    }
+    return;
+  }
+
+  std::sort(cls.begin(), cls.end());
+
+  static Stack<CodeOp*> successOps;
+  successOps.reset();
+  getSuccessOps(successOps);
+
+  size_t removedCnt=0;
+  Stack<CodeOp*>::Iterator sit(successOps);
+  while(sit.hasNext()) {
+    CodeOp* op=sit.next();
+    Clause* cl=static_cast<Clause*>(op->getSuccessResult());
+    if(std::binary_search(cls.begin(), cls.end(), cl)) {
+      op->makeFail();
+      removedCnt++;
+    }
+  }
+  if(removedCnt!=cls.size()) {
+    ASSERTION_VIOLATION;
+    INVALID_OPERATION("clause to be removed was not found");
+  }
+  _entryCnt-=removedCnt;
+
+  optimizeMemoryAfterRemovals();
+} // ClauseCodeTree::remove
+
 void ClauseCodeTree::RemovingLiteralMatcher::init(CodeOp* entry_, LitInfo* linfos_,
     size_t linfoCnt_, ClauseCodeTree* tree_, Stack<CodeOp*>* firstsInBlocks_)
 {
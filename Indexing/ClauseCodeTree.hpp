@@ -42,6 +42,7 @@ public:
 
   void insert(Clause* cl);
   void remove(Clause* cl);
+  void remove(Stack<Clause*>& cls);
 
 private:
 
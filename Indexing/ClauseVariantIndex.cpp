@@ -195,6 +195,32 @@ void SubstitutionTreeClauseVariantIndex::insert(Clause* cl)
   _strees[clen]->insert(mainLit, cl);
 }
 
+void SubstitutionTreeClauseVariantIndex::remove(Clause* cl)
+{
+  CALL("SubstitutionTreeClauseVariantIndex::remove");
+
+  unsigned clen=cl->length();
+
+  if(clen==0) {
+    _emptyClauses=ClauseList::remove(cl, _emptyClauses);
+    return;
+  }
+  if(clen==1 && (*cl)[0]->ground()) {
+    Literal* lit=(*cl)[0];
+    ClauseList** plist=_groundUnits.findPtr(lit);
+    ASS(plist);
+    *plist=ClauseList::remove(cl, *plist);
+    if(!*plist) {
+      _groundUnits.remove(lit);
+    }
+    return;
+  }
+
+  ASS(_strees[clen]);
+  Literal* mainLit=getMainLiteral(cl->literals(), clen);
+  _strees[clen]->remove(mainLit, cl);
+}
+
 Literal* SubstitutionTreeClauseVariantIndex::getMainLiteral(Literal* const * lits, unsigned length)
 {
   CALL("SubstitutionTreeClauseVariantIndex::getMainLiteral");
@@ -276,6 +302,20 @@ void HashingClauseVariantIndex::insert(Clause* cl)
   // cout << _entries.size() << "buckets after " << ++insertions << " insertions" << endl;
 }
 
+void HashingClauseVariantIndex::remove(Clause* cl)
+{
+  CALL("HashingClauseVariantIndex::remove");
+
+  unsigned h = computeHash(cl->literals(),cl->length());
+
+  ClauseList** lst=_entries.findPtr(h);
+  ASS(lst);
+  *lst=ClauseList::remove(cl, *lst);
+  if(!*lst) {
+    _entries.remove(h);
+  }
+}
+
 ClauseIterator HashingClauseVariantIndex::retrieveVariants(Literal* const * lits, unsigned length)
 {
   CALL("HashingClauseVariantIndex::retrieveVariants/2");
@@ -544,5 +584,18 @@ unsigned HashingClauseVariantIndex::computeHash(Literal* const * lits, unsigned
   return hash;
 }
 
+//-------------------//-------------------//-------------------//-------------------
+//-------------------//-------------------//-------------------//-------------------
+
+void VariantHashIndex::handleClause(Clause* c, bool adding)
+{
+  CALL("VariantHashIndex::handleClause");
+
+  if(adding) {
+    _variants.insert(c);
+  } else {
+    _variants.remove(c);
+  }
+}
 
 }
@@ -22,6 +22,8 @@
 #include "Lib/List.hpp"
 #include "Lib/DHMap.hpp"
 
+#include "Index.hpp"
+
 namespace Indexing {
 
 using namespace Lib;
@@ -33,6 +35,7 @@ public:
   virtual ~ClauseVariantIndex() {};
 
   virtual void insert(Clause* cl) = 0;
+  virtual void remove(Clause* cl) = 0;
 
   virtual ClauseIterator retrieveVariants(Literal* const * lits, unsigned length) = 0;
   ClauseIterator retrieveVariants(Clause* cl)
@@ -58,6 +61,7 @@ public:
   virtual ~SubstitutionTreeClauseVariantIndex() override;
 
   virtual void insert(Clause* cl) override;
+  virtual void remove(Clause* cl) override;
 
   ClauseIterator retrieveVariants(Literal* const * lits, unsigned length) override;
 
@@ -82,6 +86,7 @@ public:
   virtual ~HashingClauseVariantIndex() override;
 
   virtual void insert(Clause* cl) override;
+  virtual void remove(Clause* cl) override;
 
   ClauseIterator retrieveVariants(Literal* const * lits, unsigned length) override;
 
@@ -119,6 +124,27 @@ private:
   DHMap<unsigned, ClauseList*> _entries;
 };
 
+/**
+ * Index of the clauses of a container, retrieving their variants
+ * by a HashingClauseVariantIndex.
+ */
+class VariantHashIndex
+: public Index
+{
+public:
+  CLASS_NAME(VariantHashIndex);
+  USE_ALLOCATOR(VariantHashIndex);
+
+  ClauseIterator retrieveVariants(Clause* cl)
+  { return _variants.retrieveVariants(cl->literals(), cl->length()); }
+
+protected:
+  void handleClause(Clause* c, bool adding) override;
+
+private:
+  HashingClauseVariantIndex _variants;
+};
+
 };
 
 #endif /* __ClauseVariantIndex__ */
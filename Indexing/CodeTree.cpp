@@ -31,6 +31,22 @@
 
 #define GROUND_TERM_CHECK 0
 
+/**
+ * If nonzero, Matcher::execute jumps directly from each instruction to the
+ * handler of the next one through a table of label addresses (a GCC
+ * extension), instead of going through the nested switch statements.
+ *
+ * Can be set from the build, which runs the unit tests of code trees
+ * also with the switch statements.
+ */
+#ifndef THREADED_DISPATCH
+#ifdef __GNUC__
+#define THREADED_DISPATCH 1
+#else
+#define THREADED_DISPATCH 0
+#endif
+#endif
+
 #undef RSTAT_COLLECTION
 #define RSTAT_COLLECTION 0
 
@@ -624,7 +640,7 @@ inline bool CodeTree::BaseMatcher::doCheckGroundTerm()
 //////////////// auxiliary ////////////////////
 
 CodeTree::CodeTree()
-: _onCodeOpDestroying(0), _curTimeStamp(0), _maxVarCnt(1), _entryPoint(0)
+: _onCodeOpDestroying(0), _curTimeStamp(0), _maxVarCnt(1), _entryPoint(0), _entryCnt(0)
 {
 }
 
@@ -881,6 +897,8 @@ void CodeTree::incorporate(CodeStack& code)
   CALL("CodeTree::incorporate");
   ASS(code.top().isSuccess());
 
+  _entryCnt++;
+
   if(isEmpty()) {
     _entryPoint=buildBlock(code, code.length(), 0);
     code.reset();
@@ -1227,6 +1245,206 @@ void CodeTree::optimizeMemoryAfterRemoval(Stack<CodeOp*>* firstsInBlocks, CodeOp
   }
 }
 
+/**
+ * Return true if removing @b removedCnt entries by one sweep over the
+ * whole tree is cheaper than looking up each of them separately.
+ *
+ * The sweep visits every operation of the tree, while a lookup mostly
+ * follows a single path, so the sweep pays off only when a considerable
+ * part of the entries is removed.
+ */
+bool CodeTree::isSweepCheaper(size_t removedCnt)
+{
+  CALL("CodeTree::isSweepCheaper");
+  ASS_LE(removedCnt,_entryCnt);
+
+  static const size_t SWEEP_ENTRY_RATIO=16;
+  return removedCnt*SWEEP_ENTRY_RATIO>=_entryCnt;
+}
+
+/**
+ * Collect all the success operations of the tree into @b res.
+ */
+void CodeTree::getSuccessOps(Stack<CodeOp*>& res)
+{
+  CALL("CodeTree::getSuccessOps");
+
+  visitAllOps([&res](CodeOp* op) {
+    if(op->isSuccess()) {
+      res.push(op);
+    }
+  });
+}
+
+/**
+ * Remove the code that became useless after any number of success
+ * operations were turned into fail operations.
+ *
+ * This does for many removed operations what @b optimizeMemoryAfterRemoval
+ * does for one, but it visits each operation of the tree only once instead
+ * of following the path to each removed operation.
+ */
+void CodeTree::optimizeMemoryAfterRemovals()
+{
+  CALL("CodeTree::optimizeMemoryAfterRemovals");
+
+  if(isEmpty()) {
+    return;
+  }
+
+  // first operations of CodeBlocks and landingOps of SearchStructs, each
+  // with a flag saying whether the ones it points to were already pushed
+  static Stack<pair<CodeOp*,bool> > todo;
+  // what the processed operations are to be replaced by (0 if removed)
+  static DHMap<CodeOp*,CodeOp*> replacements;
+  todo.reset();
+  replacements.reset();
+
+  CodeOp* entry=getEntryPoint();
+  todo.push(make_pair(entry,false));
+  while(todo.isNonEmpty()) {
+    CodeOp* top=todo.top().first;
+    if(!todo.top().second) {
+      // the operations pointed to are processed first
+      todo.top().second=true;
+      if(top->isSearchStruct()) {
+        if(top->alternative()) {
+          todo.push(make_pair(top->alternative(),false));
+        }
+        FixedSearchStruct* ss=static_cast<FixedSearchStruct*>(top->getSearchStruct());
+        ASS(ss->isFixedSearchStruct());
+        for(size_t i=0; i<ss->length; i++) {
+          if(ss->targets[i]) {
+            todo.push(make_pair(ss->targets[i],false));
+          }
+        }
+      }
+      else {
+        CodeBlock* cb=firstOpToCodeBlock(top);
+        CodeOp* op=top;
+        for(size_t rem=cb->length(); rem; rem--,op++) {
+          if(op->alternative()) {
+            todo.push(make_pair(op->alternative(),false));
+          }
+        }
+      }
+      continue;
+    }
+    todo.pop();
+
+    CodeOp* res=top->isSearchStruct() ?
+	optimizeSearchStructAfterRemovals(top, replacements) :
+	optimizeBlockAfterRemovals(top, replacements);
+    ALWAYS(replacements.insert(top, res));
+  }
+
+  CodeOp* newEntry=replacements.get(entry);
+  if(newEntry!=entry) {
+    ASS(!newEntry || !newEntry->isSearchStruct());
+    _entryPoint=newEntry ? firstOpToCodeBlock(newEntry) : 0;
+  }
+}
+
+/**
+ * Remove the useless code of the CodeBlock starting at @b firstOp after
+ * the operations it points to were processed, and return what the block
+ * is to be replaced by (0 if it can be removed entirely).
+ */
+CodeTree::CodeOp* CodeTree::optimizeBlockAfterRemovals(CodeOp* firstOp, DHMap<CodeOp*,CodeOp*>& replacements)
+{
+  CALL("CodeTree::optimizeBlockAfterRemovals");
+
+  CodeBlock* cb=firstOpToCodeBlock(firstOp);
+  // true if the operations after the current one can still lead to a success
+  bool cont=false;
+  // true if the current operation itself can lead to a success
+  bool live=false;
+  for(size_t i=cb->length(); i>0; i--) {
+    CodeOp* op=&(*cb)[i-1];
+    if(op->alternative()) {
+      CodeOp* alt=0;
+      ALWAYS(replacements.pop(op->alternative(), alt));
+      op->setAlternative(alt);
+    }
+    live=op->isSuccess() || (!op->isFail() && cont);
+    if(!live && i>1 && op->alternative() && !op->isFail()) {
+      //only the alternative remains, as in optimizeMemoryAfterRemoval
+      makeFailAfterRemovals(op);
+    }
+    cont=live || op->alternative();
+  }
+  if(live) {
+    return firstOp;
+  }
+
+  CodeOp* alt=firstOp->alternative();
+  if(cb==_entryPoint && alt && alt->isSearchStruct()) {
+    //the entry point cannot be replaced by a SearchStruct
+    makeFailAfterRemovals(firstOp);
+    return firstOp;
+  }
+
+  if(_clauseCodeTree) {
+    //delete ILStruct objects
+    size_t cbLen=cb->length();
+    for(size_t i=0;i<cbLen;i++) {
+      if((*cb)[i].isLitEnd()) {
+	delete (*cb)[i].getILS();
+      }
+    }
+  }
+  cb->deallocate();
+  return alt;
+}
+
+/**
+ * Remove the useless targets of the SearchStruct with @b landingOp after
+ * they were processed, and return what the SearchStruct is to be replaced
+ * by (its alternative if it has no targets left).
+ */
+CodeTree::CodeOp* CodeTree::optimizeSearchStructAfterRemovals(CodeOp* landingOp, DHMap<CodeOp*,CodeOp*>& replacements)
+{
+  CALL("CodeTree::optimizeSearchStructAfterRemovals");
+
+  FixedSearchStruct* ss=static_cast<FixedSearchStruct*>(landingOp->getSearchStruct());
+  bool empty=true;
+  for(size_t i=0; i<ss->length; i++) {
+    if(ss->targets[i]) {
+      CodeOp* tgt=0;
+      ALWAYS(replacements.pop(ss->targets[i], tgt));
+      ASS(!tgt || (ss->kind==SearchStruct::FN_STRUCT && tgt->isCheckFun()) ||
+	  (ss->kind==SearchStruct::GROUND_TERM_STRUCT && tgt->isCheckGroundTerm()) );
+      ss->targets[i]=tgt;
+      empty=empty && !tgt;
+    }
+  }
+  if(landingOp->alternative()) {
+    CodeOp* alt=0;
+    ALWAYS(replacements.pop(landingOp->alternative(), alt));
+    landingOp->setAlternative(alt);
+  }
+  if(!empty) {
+    return landingOp;
+  }
+  CodeOp* alt=landingOp->alternative();
+  ss->destroy();
+  return alt;
+}
+
+/**
+ * Turn @b op into a fail operation, keeping its alternative.
+ */
+void CodeTree::makeFailAfterRemovals(CodeOp* op)
+{
+  CALL("CodeTree::makeFailAfterRemovals");
+  ASS(!op->isSuccess());
+
+  if(_clauseCodeTree && op->isLitEnd()) {
+    delete op->getILS();
+  }
+  op->makeFail();
+}
+
 void CodeTree::RemovingMatcher::init(CodeOp* entry_, LitInfo* linfos_,
     size_t linfoCnt_, CodeTree* tree_, Stack<CodeOp*>* firstsInBlocks_)
 {
@@ -1459,6 +1677,69 @@ bool CodeTree::Matcher::execute()
   }
 
 
+#if THREADED_DISPATCH
+  //indexed by CodeOp::instrCode(); for instructions other than SUFFIX_INSTR
+  //the suffix bits belong to the instruction data, so all their values
+  //lead to the same handler
+  static void* const handlers[16] = {
+    &&successOrFail, &&checkGroundTerm, &&litEnd, &&checkFun,
+    &&successOrFail, &&checkGroundTerm, &&litEnd, &&assignVar,
+    &&successOrFail, &&checkGroundTerm, &&litEnd, &&checkVar,
+    &&successOrFail, &&checkGroundTerm, &&litEnd, &&searchStruct
+  };
+
+#define DISPATCH_OP                                          \
+  if(op->alternative()) {                                    \
+    btStack.push(BTPoint(tp, op->alternative()));            \
+  }                                                          \
+  goto *handlers[op->instrCode()];
+
+  DISPATCH_OP
+
+successOrFail:
+  //yield successes only in the first round (we don't want to yield the
+  //same thing for each query literal)
+  if(op->isFail() || curLInfo!=0) {
+    goto backtrackOp;
+  }
+  return true;
+litEnd:
+  return true;
+checkGroundTerm:
+  if(!doCheckGroundTerm()) {
+    goto backtrackOp;
+  }
+  op++;
+  DISPATCH_OP
+checkFun:
+  if(!doCheckFun()) {
+    goto backtrackOp;
+  }
+  op++;
+  DISPATCH_OP
+assignVar:
+  doAssignVar();
+  op++;
+  DISPATCH_OP
+checkVar:
+  if(!doCheckVar()) {
+    goto backtrackOp;
+  }
+  op++;
+  DISPATCH_OP
+searchStruct:
+  if(doSearchStruct()) {
+    //a new value of @b op is assigned
+    DISPATCH_OP
+  }
+backtrackOp:
+  if(!backtrack()) {
+    return false;
+  }
+  DISPATCH_OP
+
+#undef DISPATCH_OP
+#else
   bool shouldBacktrack=false;
   for(;;) {
     if(op->alternative()) {
@@ -1522,6 +1803,7 @@ bool CodeTree::Matcher::execute()
       op++;
     }
   }
+#endif
 }
 
 /**
@@ -222,6 +222,14 @@ public:
       return static_cast<InstructionSuffix>(_info.suffix);
     }
 
+    /**
+     * Return the instruction prefix and suffix packed into a number below 16
+     *
+     * Unless the prefix is SUFFIX_INSTR, the suffix bits are a part of
+     * the instruction data and have an arbitrary value.
+     */
+    inline unsigned instrCode() const { return _info.prefix | (_info.suffix<<2); }
+
     inline unsigned arg() const { return _info.arg; }
     inline CodeOp* alternative() const { return _alternative; }
     inline CodeOp*& alternative() { return _alternative; }
@@ -388,6 +396,13 @@ public:
 
   void optimizeMemoryAfterRemoval(Stack<CodeOp*>* firstsInBlocks, CodeOp* removedOp);
 
+  bool isSweepCheaper(size_t removedCnt);
+  void getSuccessOps(Stack<CodeOp*>& res);
+  void optimizeMemoryAfterRemovals();
+  CodeOp* optimizeBlockAfterRemovals(CodeOp* firstOp, DHMap<CodeOp*,CodeOp*>& replacements);
+  CodeOp* optimizeSearchStructAfterRemovals(CodeOp* landingOp, DHMap<CodeOp*,CodeOp*>& replacements);
+  void makeFailAfterRemovals(CodeOp* op);
+
   struct RemovingMatcher
   : public BaseMatcher
   {
@@ -537,6 +552,9 @@ public:
 
   CodeBlock* _entryPoint;
 
+  /** number of clauses or terms stored in the tree */
+  size_t _entryCnt;
+
 };
 
 }
@@ -192,10 +192,40 @@ void CodeTreeTIS::insert(TermList t, Literal* lit, Clause* cls)
 void CodeTreeTIS::remove(TermList t, Literal* lit, Clause* cls)
 {
   CALL("CodeTreeTIS::remove");
-  
+
+  if(_collectRemovals) {
+    _removals.push(new TermCodeTree::TermInfo(t,lit,cls));
+    return;
+  }
   _ct.remove(TermCodeTree::TermInfo(t,lit,cls));
 }
 
+/**
+ * Collect the following removals, so that they are performed in one
+ * pass over the code tree. Insertions are still performed immediately.
+ */
+void CodeTreeTIS::startBatch(bool adding)
+{
+  CALL("CodeTreeTIS::startBatch");
+  ASS(!_collectRemovals);
+  ASS(_removals.isEmpty());
+
+  _collectRemovals=!adding;
+}
+
+void CodeTreeTIS::finishBatch()
+{
+  CALL("CodeTreeTIS::finishBatch");
+
+  _collectRemovals=false;
+  if(_removals.isNonEmpty()) {
+    _ct.remove(_removals);
+    while(_removals.isNonEmpty()) {
+      delete _removals.pop();
+    }
+  }
+}
+
 TermQueryResultIterator CodeTreeTIS::getGeneralizations(TermList t, bool retrieveSubstitutions)
 {
   CALL("CodeTreeTIS::getGeneralizations");
@@ -453,6 +483,23 @@ void CodeTreeSubsumptionIndex::handleClause(Clause* cl, bool adding)
   }
 }
 
+/**
+ * Removals are performed together by the code tree,
+ * insertions one by one.
+ */
+void CodeTreeSubsumptionIndex::handleClauses(Stack<Clause*>& clauses, bool adding)
+{
+  CALL("CodeTreeSubsumptionIndex::handleClauses");
+
+  if(adding) {
+    Index::handleClauses(clauses, adding);
+    return;
+  }
+
+  TimeCounter tc(TC_FORWARD_SUBSUMPTION_INDEX_MAINTENANCE);
+  _ct.remove(clauses);
+}
+
 ClauseSResResultIterator CodeTreeSubsumptionIndex
 	::getSubsumingOrSResolvingClauses(Clause* cl, bool subsumptionResolution)
 {
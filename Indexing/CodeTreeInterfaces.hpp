@@ -43,9 +43,14 @@ public:
   CLASS_NAME(CodeTreeTIS);
   USE_ALLOCATOR(CodeTreeTIS);
 
+  CodeTreeTIS() : _collectRemovals(false) {}
+
   void insert(TermList t, Literal* lit, Clause* cls);
   void remove(TermList t, Literal* lit, Clause* cls);
 
+  void startBatch(bool adding) override;
+  void finishBatch() override;
+
   TermQueryResultIterator getGeneralizations(TermList t, bool retrieveSubstitutions = true);
   bool generalizationExists(TermList t);
 
@@ -57,6 +62,9 @@ private:
   class ResultIterator;
 
   TermCodeTree _ct;
+  /** true if removals are collected in _removals (insertions are immediate) */
+  bool _collectRemovals;
+  Stack<TermCodeTree::TermInfo*> _removals;
 };
 /*
 class CodeTreeLIS : public LiteralIndexingStructure
@@ -86,6 +94,7 @@ public:
 protected:
   //overrides Index::handleClause
   void handleClause(Clause* c, bool adding);
+  void handleClauses(Stack<Clause*>& clauses, bool adding) override;
 private:
   class ClauseSResIterator;
 
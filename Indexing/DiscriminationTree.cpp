@@ -0,0 +1,554 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file DiscriminationTree.cpp
+ * Implements class DiscriminationTree.
+ */
+
+#include "Lib/Metaiterators.hpp"
+#include "Lib/VirtualIterator.hpp"
+
+#include "Kernel/Renaming.hpp"
+#include "Kernel/RobSubstitution.hpp"
+#include "Kernel/SubstHelper.hpp"
+#include "Kernel/Term.hpp"
+
+#include "ResultSubstitution.hpp"
+
+#include "DiscriminationTree.hpp"
+
+namespace Indexing
+{
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * Return the index of the first edge in @b edges whose number is
+ * not smaller than @b number, or the number of edges if there is none.
+ */
+unsigned DiscriminationTree::Node::edgeIndex(const Stack<Edge>& edges, unsigned number)
+{
+  unsigned lo=0;
+  unsigned hi=edges.size();
+  while(lo<hi) {
+    unsigned mid=(lo+hi)/2;
+    if(edges[mid].number<number) {
+      lo=mid+1;
+    }
+    else {
+      hi=mid;
+    }
+  }
+  return lo;
+}
+
+/**
+ * Remove the edge leading to @b child from @b edges, keeping the remaining
+ * edges sorted. Return false if there is no such edge.
+ */
+bool DiscriminationTree::Node::removeEdge(Stack<Edge>& edges, Node* child)
+{
+  for(unsigned i=0;i<edges.size();i++) {
+    if(edges[i].child!=child) {
+      continue;
+    }
+    for(unsigned j=i+1;j<edges.size();j++) {
+      edges[j-1]=edges[j];
+    }
+    edges.pop();
+    return true;
+  }
+  return false;
+}
+
+/**
+ * Return the child reached through the edge labelled by @b functor,
+ * or zero if there is no such edge.
+ */
+DiscriminationTree::Node* DiscriminationTree::Node::funChild(unsigned functor) const
+{
+  unsigned idx=edgeIndex(funEdges, functor);
+  if(idx<funEdges.size() && funEdges[idx].number==functor) {
+    return funEdges[idx].child;
+  }
+  return 0;
+}
+
+/**
+ * Return the child reached through the edge labelled by the normalized
+ * variable @b normVar, or zero if there is no such edge.
+ */
+DiscriminationTree::Node* DiscriminationTree::Node::varChild(unsigned normVar) const
+{
+  unsigned idx=edgeIndex(varEdges, normVar);
+  if(idx<varEdges.size() && varEdges[idx].number==normVar) {
+    return varEdges[idx].child;
+  }
+  return 0;
+}
+
+/**
+ * Return the child reached through the edge labelled by the top symbol
+ * of @b t, creating it if it does not exist. If @b t is a variable,
+ * the edge is labelled by @b normVar.
+ */
+DiscriminationTree::Node* DiscriminationTree::Node::getOrCreateChild(TermList t, unsigned normVar)
+{
+  CALL("DiscriminationTree::Node::getOrCreateChild");
+
+  Stack<Edge>& edges=t.isVar() ? varEdges : funEdges;
+  unsigned number=t.isVar() ? normVar : t.term()->functor();
+  unsigned idx=edgeIndex(edges, number);
+  if(idx<edges.size() && edges[idx].number==number) {
+    return edges[idx].child;
+  }
+
+  Node* child=new Node(t.isVar() ? 0 : t.term()->arity());
+  edges.push(Edge());
+  for(unsigned i=edges.size()-1;i>idx;i--) {
+    edges[i]=edges[i-1];
+  }
+  edges[idx].number=number;
+  edges[idx].child=child;
+  return child;
+}
+
+/**
+ * Remove the edge leading to @b child.
+ */
+void DiscriminationTree::Node::removeChild(Node* child)
+{
+  CALL("DiscriminationTree::Node::removeChild");
+
+  if(!removeEdge(funEdges, child)) {
+    ALWAYS(removeEdge(varEdges, child));
+  }
+}
+
+/**
+ * Push the subterms of @b t to @b terms in preorder. If @b ends is
+ * nonzero, the position right after the subterm starting at position i
+ * is stored at (*ends)[i].
+ */
+void DiscriminationTree::flatten(TermList t, Stack<TermList>& terms, Stack<unsigned>* ends)
+{
+  CALL("DiscriminationTree::flatten");
+
+  static Stack<TermList*> toDo;
+  terms.reset();
+  toDo.reset();
+
+  terms.push(t);
+  if(t.isTerm()) {
+    toDo.push(t.term()->args());
+  }
+  while(toDo.isNonEmpty()) {
+    TermList* ts=toDo.pop();
+    if(ts->isEmpty()) {
+      continue;
+    }
+    terms.push(*ts);
+    toDo.push(ts->next());
+    if(ts->isTerm()) {
+      toDo.push(ts->term()->args());
+    }
+  }
+
+  if(!ends) {
+    return;
+  }
+  // the end of a subterm is the end of its last argument, so the ends
+  // are computed from the right
+  ends->reset();
+  for(unsigned i=0;i<terms.size();i++) {
+    ends->push(0);
+  }
+  for(unsigned i=terms.size();i>0;) {
+    i--;
+    unsigned end=i+1;
+    if(terms[i].isTerm()) {
+      for(unsigned arg=terms[i].term()->arity();arg>0;arg--) {
+        end=(*ends)[end];
+      }
+    }
+    (*ends)[i]=end;
+  }
+}
+
+DiscriminationTree::DiscriminationTree()
+: _root(new Node(0))
+{
+}
+
+DiscriminationTree::~DiscriminationTree()
+{
+  CALL("DiscriminationTree::~DiscriminationTree");
+
+  static Stack<Node*> toDelete;
+  toDelete.reset();
+  toDelete.push(_root);
+  while(toDelete.isNonEmpty()) {
+    Node* n=toDelete.pop();
+    for(unsigned i=0;i<n->funEdges.size();i++) {
+      toDelete.push(n->funEdges[i].child);
+    }
+    for(unsigned i=0;i<n->varEdges.size();i++) {
+      toDelete.push(n->varEdges[i].child);
+    }
+    delete n;
+  }
+}
+
+void DiscriminationTree::insert(TermList t, Literal* lit, Clause* cls)
+{
+  CALL("DiscriminationTree::insert");
+
+  static Stack<TermList> terms;
+  static Renaming normalizer;
+  flatten(t, terms, 0);
+  normalizer.reset();
+
+  Node* n=_root;
+  for(unsigned i=0;i<terms.size();i++) {
+    TermList s=terms[i];
+    n=n->getOrCreateChild(s, s.isVar() ? normalizer.getOrBind(s.var()) : 0);
+  }
+  ASS(n->funEdges.isEmpty());
+  ASS(n->varEdges.isEmpty());
+
+  Entry e;
+  e.t=t;
+  e.lit=lit;
+  e.cls=cls;
+  n->entries.push(e);
+}
+
+void DiscriminationTree::remove(TermList t, Literal* lit, Clause* cls)
+{
+  CALL("DiscriminationTree::remove");
+
+  static Stack<TermList> terms;
+  static Stack<Node*> path;
+  static Renaming normalizer;
+  flatten(t, terms, 0);
+  normalizer.reset();
+  path.reset();
+
+  Node* n=_root;
+  path.push(n);
+  for(unsigned i=0;i<terms.size();i++) {
+    TermList s=terms[i];
+    n=s.isVar() ? n->varChild(normalizer.getOrBind(s.var())) : n->funChild(s.term()->functor());
+    ASS(n);
+    path.push(n);
+  }
+
+  Stack<Entry>& entries=n->entries;
+  for(unsigned i=0;i<entries.size();i++) {
+    Entry& e=entries[i];
+    if(e.t==t && e.lit==lit && e.cls==cls) {
+      e=entries.top();
+      entries.pop();
+      break;
+    }
+  }
+
+  // nodes left without terms below them are removed
+  while(path.size()>1 && path.top()->isEmpty()) {
+    Node* child=path.pop();
+    path.top()->removeChild(child);
+    delete child;
+  }
+}
+
+/**
+ * Substitution of a retrieved generalization. The bindings are indexed
+ * by normalized variables of the result term, so the variables of the
+ * result are normalized in the same way as when the term was inserted.
+ */
+class DiscriminationTree::GenSubstitution
+: public ResultSubstitution
+{
+public:
+  CLASS_NAME(DiscriminationTree::GenSubstitution);
+  USE_ALLOCATOR(GenSubstitution);
+
+  GenSubstitution(Stack<TermList>* bindings) : _bindings(bindings) {}
+
+  void setResult(TermList t)
+  {
+    _resultNormalizer.reset();
+    _resultNormalizer.normalizeVariables(t);
+  }
+
+  TermList applyToBoundResult(TermList t) override
+  {
+    CALL("DiscriminationTree::GenSubstitution::applyToBoundResult(TermList)");
+    return SubstHelper::apply(t, *this);
+  }
+
+  Literal* applyToBoundResult(Literal* lit) override
+  {
+    CALL("DiscriminationTree::GenSubstitution::applyToBoundResult(Literal*)");
+    return SubstHelper::apply(lit, *this);
+  }
+
+  bool isIdentityOnQueryWhenResultBound() override { return true; }
+
+  TermList apply(unsigned var)
+  {
+    ASS(_resultNormalizer.contains(var));
+    TermList res=(*_bindings)[_resultNormalizer.get(var)];
+    ASS(res.isTerm()||res.isOrdinaryVar());
+    return res;
+  }
+
+private:
+  Stack<TermList>* _bindings;
+  Renaming _resultNormalizer;
+};
+
+/**
+ * Iterator over the terms retrieved from the tree. The tree is traversed
+ * depth-first with an explicit stack of states, each of which is a node
+ * together with the position in the preorder traversal of the query that
+ * is to be matched against the edges leaving the node.
+ */
+class DiscriminationTree::ResultIterator
+: public IteratorCore<TermQueryResult>
+{
+public:
+  CLASS_NAME(DiscriminationTree::ResultIterator);
+  USE_ALLOCATOR(ResultIterator);
+
+  ResultIterator(Node* root, RetrievalMode mode, TermList query, bool retrieveSubstitutions)
+  : _mode(mode), _query(query), _retrieveSubstitutions(retrieveSubstitutions),
+    _leaf(0), _leafIndex(0), _found(0), _genSubst(0)
+  {
+    CALL("DiscriminationTree::ResultIterator::ResultIterator");
+
+    flatten(query, _terms, &_ends);
+    _states.push(State(root, 0, 0, 0));
+    if(_mode==GENERALIZATIONS && _retrieveSubstitutions) {
+      _genSubst=new GenSubstitution(&_bindings);
+    }
+  }
+
+  ~ResultIterator()
+  {
+    if(_genSubst) {
+      delete _genSubst;
+    }
+  }
+
+  bool hasNext()
+  {
+    CALL("DiscriminationTree::ResultIterator::hasNext");
+
+    if(_found) {
+      return true;
+    }
+    for(;;) {
+      while(_leaf && _leafIndex<_leaf->entries.size()) {
+        Entry* e=&_leaf->entries[_leafIndex++];
+        if(verify(*e)) {
+          _found=e;
+          return true;
+        }
+      }
+      _leaf=0;
+      if(_states.isEmpty()) {
+        return false;
+      }
+      State s=_states.pop();
+      if(!s.binding.isEmpty()) {
+        _bindings.truncate(s.bound-1);
+        _bindings.push(s.binding);
+      }
+      expand(s);
+    }
+  }
+
+  TermQueryResult next()
+  {
+    CALL("DiscriminationTree::ResultIterator::next");
+    ASS(_found);
+
+    Entry* e=_found;
+    _found=0;
+    if(!_retrieveSubstitutions) {
+      return TermQueryResult(e->t, e->lit, e->cls);
+    }
+    if(_mode==GENERALIZATIONS) {
+      _genSubst->setResult(e->t);
+      return TermQueryResult(e->t, e->lit, e->cls, ResultSubstitutionSP(_genSubst,true));
+    }
+    return TermQueryResult(e->t, e->lit, e->cls,
+        ResultSubstitution::fromSubstitution(&_subst, QUERY_BANK, RESULT_BANK));
+  }
+
+private:
+  static const int QUERY_BANK=0;
+  static const int RESULT_BANK=1;
+
+  struct State
+  {
+    State(Node* node, unsigned pos, unsigned skip, unsigned bound)
+    : node(node), pos(pos), skip(skip), bound(bound) { binding.makeEmpty(); }
+    State(Node* node, unsigned pos, unsigned skip, unsigned bound, TermList binding)
+    : node(node), pos(pos), skip(skip), bound(bound), binding(binding) {}
+
+    Node* node;
+    /** position in the query traversal that follows the node */
+    unsigned pos;
+    /** number of subterms in the tree still to be skipped for a query variable */
+    unsigned skip;
+    /** number of tree variables bound on the path to the node */
+    unsigned bound;
+    /** binding of the tree variable bound-1 made on the edge into the node, if any */
+    TermList binding;
+  };
+
+  /**
+   * Generalizations are exact, the other candidates were found
+   * ignoring repeated variables, so they need to be checked.
+   */
+  bool verify(Entry& e)
+  {
+    CALL("DiscriminationTree::ResultIterator::verify");
+
+    switch(_mode) {
+    case GENERALIZATIONS:
+      return true;
+    case INSTANCES:
+      _subst.reset();
+      return _subst.match(_query, QUERY_BANK, e.t, RESULT_BANK);
+    case UNIFICATIONS:
+      _subst.reset();
+      return _subst.unify(_query, QUERY_BANK, e.t, RESULT_BANK);
+    }
+    ASSERTION_VIOLATION;
+  }
+
+  void expand(const State& s)
+  {
+    CALL("DiscriminationTree::ResultIterator::expand");
+
+    Node* n=s.node;
+    if(s.skip) {
+      for(unsigned i=0;i<n->varEdges.size();i++) {
+        _states.push(State(n->varEdges[i].child, s.pos, s.skip-1, s.bound));
+      }
+      for(unsigned i=0;i<n->funEdges.size();i++) {
+        Node* c=n->funEdges[i].child;
+        _states.push(State(c, s.pos, s.skip-1+c->arity, s.bound));
+      }
+      return;
+    }
+    if(s.pos==_terms.size()) {
+      _leaf=n;
+      _leafIndex=0;
+      return;
+    }
+
+    TermList q=_terms[s.pos];
+    unsigned after=_ends[s.pos];
+    if(_mode==GENERALIZATIONS) {
+      for(unsigned i=0;i<n->varEdges.size();i++) {
+        unsigned var=n->varEdges[i].number;
+        Node* c=n->varEdges[i].child;
+        if(var<s.bound) {
+          if(TermList::equals(_bindings[var], q)) {
+            _states.push(State(c, after, 0, s.bound));
+          }
+        }
+        else {
+          ASS_EQ(var, s.bound);
+          _states.push(State(c, after, 0, s.bound+1, q));
+        }
+      }
+    }
+    else if(_mode==UNIFICATIONS || q.isVar()) {
+      for(unsigned i=0;i<n->varEdges.size();i++) {
+        _states.push(State(n->varEdges[i].child, after, 0, s.bound));
+      }
+    }
+
+    if(q.isTerm()) {
+      Node* c=n->funChild(q.term()->functor());
+      if(c) {
+        _states.push(State(c, s.pos+1, 0, s.bound));
+      }
+    }
+    else if(_mode!=GENERALIZATIONS) {
+      // the query variable stands for a whole subterm of the tree
+      for(unsigned i=0;i<n->funEdges.size();i++) {
+        Node* c=n->funEdges[i].child;
+        _states.push(State(c, after, c->arity, s.bound));
+      }
+    }
+  }
+
+  RetrievalMode _mode;
+  TermList _query;
+  bool _retrieveSubstitutions;
+
+  /** subterms of the query in preorder */
+  Stack<TermList> _terms;
+  /** positions right after the query subterms in @b _terms */
+  Stack<unsigned> _ends;
+  Stack<State> _states;
+  /** bindings of the normalized tree variables, for generalizations */
+  Stack<TermList> _bindings;
+
+  Node* _leaf;
+  unsigned _leafIndex;
+  Entry* _found;
+
+  GenSubstitution* _genSubst;
+  RobSubstitution _subst;
+};
+
+TermQueryResultIterator DiscriminationTree::getResultIterator(RetrievalMode mode, TermList t,
+    bool retrieveSubstitutions)
+{
+  CALL("DiscriminationTree::getResultIterator");
+
+  return vi( new ResultIterator(_root, mode, t, retrieveSubstitutions) );
+}
+
+TermQueryResultIterator DiscriminationTree::getUnifications(TermList t,
+    bool retrieveSubstitutions)
+{
+  return getResultIterator(UNIFICATIONS, t, retrieveSubstitutions);
+}
+
+TermQueryResultIterator DiscriminationTree::getGeneralizations(TermList t,
+    bool retrieveSubstitutions)
+{
+  return getResultIterator(GENERALIZATIONS, t, retrieveSubstitutions);
+}
+
+TermQueryResultIterator DiscriminationTree::getInstances(TermList t,
+    bool retrieveSubstitutions)
+{
+  return getResultIterator(INSTANCES, t, retrieveSubstitutions);
+}
+
+bool DiscriminationTree::generalizationExists(TermList t)
+{
+  CALL("DiscriminationTree::generalizationExists");
+
+  ResultIterator it(_root, GENERALIZATIONS, t, false);
+  return it.hasNext();
+}
+
+}
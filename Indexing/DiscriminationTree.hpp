@@ -0,0 +1,135 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file DiscriminationTree.hpp
+ * Defines class DiscriminationTree.
+ */
+
+#ifndef __DiscriminationTree__
+#define __DiscriminationTree__
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Term.hpp"
+
+#include "Index.hpp"
+#include "TermIndexingStructure.hpp"
+
+namespace Indexing {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * Perfect discrimination tree over preorder traversals of terms.
+ *
+ * A term is stored at the end of the path spelled by its preorder
+ * traversal, where function symbols are represented by their functors
+ * and variables by their position in the order of first occurrence.
+ * As distinct variables stay distinct, the terms stored in one node
+ * are variants of each other, so generalizations are retrieved without
+ * any further check. For instances and unifiers, a query variable skips
+ * a whole subterm of the tree, and the candidates found this way are
+ * verified by a RobSubstitution.
+ */
+class DiscriminationTree
+: public TermIndexingStructure
+{
+public:
+  CLASS_NAME(DiscriminationTree);
+  USE_ALLOCATOR(DiscriminationTree);
+
+  DiscriminationTree();
+  ~DiscriminationTree();
+
+  void insert(TermList t, Literal* lit, Clause* cls) override;
+  void remove(TermList t, Literal* lit, Clause* cls) override;
+
+  TermQueryResultIterator getUnifications(TermList t,
+	  bool retrieveSubstitutions = true) override;
+  TermQueryResultIterator getGeneralizations(TermList t,
+	  bool retrieveSubstitutions = true) override;
+  TermQueryResultIterator getInstances(TermList t,
+	  bool retrieveSubstitutions = true) override;
+
+  bool generalizationExists(TermList t) override;
+
+#if VDEBUG
+  void markTagged() override {}
+#endif
+
+private:
+  enum RetrievalMode {
+    GENERALIZATIONS,
+    INSTANCES,
+    UNIFICATIONS
+  };
+
+  struct Entry
+  {
+    TermList t;
+    Literal* lit;
+    Clause* cls;
+  };
+
+  struct Node;
+
+  /** Edge leading to @b child, labelled by a functor or a variable number */
+  struct Edge
+  {
+    unsigned number;
+    Node* child;
+  };
+
+  struct Node
+  {
+    CLASS_NAME(DiscriminationTree::Node);
+    USE_ALLOCATOR(Node);
+
+    Node(unsigned arity) : arity(arity) {}
+
+    bool isEmpty() const
+    { return entries.isEmpty() && funEdges.isEmpty() && varEdges.isEmpty(); }
+
+    Node* funChild(unsigned functor) const;
+    Node* varChild(unsigned normVar) const;
+    Node* getOrCreateChild(TermList t, unsigned normVar);
+    void removeChild(Node* child);
+
+    static unsigned edgeIndex(const Stack<Edge>& edges, unsigned number);
+    static bool removeEdge(Stack<Edge>& edges, Node* child);
+
+    /** Arity of the symbol labelling the edge into this node, 0 for variables */
+    unsigned arity;
+    /** Edges labelled by functors, sorted by the functor */
+    Stack<Edge> funEdges;
+    /** Edges labelled by normalized variables, sorted by the variable number */
+    Stack<Edge> varEdges;
+    /** Terms whose traversal ends in this node */
+    Stack<Entry> entries;
+  };
+
+  class GenSubstitution;
+  class ResultIterator;
+
+  static void flatten(TermList t, Stack<TermList>& terms, Stack<unsigned>* ends);
+
+  TermQueryResultIterator getResultIterator(RetrievalMode mode, TermList t,
+      bool retrieveSubstitutions);
+
+  Node* _root;
+};
+
+};
+
+#endif // __DiscriminationTree__
@@ -0,0 +1,400 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file FingerprintIndex.cpp
+ * Implements class FingerprintIndex.
+ */
+
+#include "Lib/Metaiterators.hpp"
+#include "Lib/VirtualIterator.hpp"
+
+#include "Kernel/RobSubstitution.hpp"
+#include "Kernel/Term.hpp"
+
+#include "ResultSubstitution.hpp"
+
+#include "FingerprintIndex.hpp"
+
+namespace Indexing
+{
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * Sampled positions, each given by its length followed by
+ * the (zero-based) argument indexes: the root, its first three
+ * arguments and the first two arguments of its first two arguments.
+ */
+static const unsigned FINGERPRINT_POSITIONS[][3] = {
+  {0, 0, 0},
+  {1, 0, 0},
+  {1, 1, 0},
+  {1, 2, 0},
+  {2, 0, 0},
+  {2, 0, 1},
+  {2, 1, 0},
+  {2, 1, 1}
+};
+
+/**
+ * Return the index of the first edge in @b edges whose feature is
+ * not smaller than @b feature, or the number of edges if there is none.
+ */
+unsigned FingerprintIndex::Node::edgeIndex(const Stack<Edge>& edges, unsigned feature)
+{
+  unsigned lo=0;
+  unsigned hi=edges.size();
+  while(lo<hi) {
+    unsigned mid=(lo+hi)/2;
+    if(edges[mid].feature<feature) {
+      lo=mid+1;
+    }
+    else {
+      hi=mid;
+    }
+  }
+  return lo;
+}
+
+FingerprintIndex::Node* FingerprintIndex::Node::child(unsigned feature) const
+{
+  unsigned idx=edgeIndex(children, feature);
+  if(idx<children.size() && children[idx].feature==feature) {
+    return children[idx].child;
+  }
+  return 0;
+}
+
+FingerprintIndex::Node* FingerprintIndex::Node::getOrCreateChild(unsigned feature)
+{
+  CALL("FingerprintIndex::Node::getOrCreateChild");
+
+  unsigned idx=edgeIndex(children, feature);
+  if(idx<children.size() && children[idx].feature==feature) {
+    return children[idx].child;
+  }
+
+  Node* res=new Node();
+  children.push(Edge());
+  for(unsigned i=children.size()-1;i>idx;i--) {
+    children[i]=children[i-1];
+  }
+  children[idx].feature=feature;
+  children[idx].child=res;
+  return res;
+}
+
+void FingerprintIndex::Node::removeChild(unsigned feature)
+{
+  CALL("FingerprintIndex::Node::removeChild");
+
+  unsigned idx=edgeIndex(children, feature);
+  ASS_L(idx,children.size());
+  ASS_EQ(children[idx].feature,feature);
+  for(unsigned i=idx+1;i<children.size();i++) {
+    children[i-1]=children[i];
+  }
+  children.pop();
+}
+
+/**
+ * Return the feature of the term @b t at the sampled position @b position.
+ */
+unsigned FingerprintIndex::feature(TermList t, unsigned position)
+{
+  const unsigned* pos=FINGERPRINT_POSITIONS[position];
+  for(unsigned i=1;i<=pos[0];i++) {
+    if(t.isVar()) {
+      return BELOW_VARIABLE;
+    }
+    Term* trm=t.term();
+    if(pos[i]>=trm->arity()) {
+      return NONEXISTENT;
+    }
+    t=*trm->nthArgument(pos[i]);
+  }
+  return t.isVar() ? VARIABLE : FUNCTION+t.term()->functor();
+}
+
+/**
+ * Return true if a query term with feature @b queryFeature at some
+ * position may be related by @b mode to an indexed term with feature
+ * @b indexFeature at the same position.
+ */
+bool FingerprintIndex::compatible(RetrievalMode mode, unsigned queryFeature, unsigned indexFeature)
+{
+  switch(mode) {
+  case GENERALIZATIONS:
+    // the indexed term is the more general one
+    std::swap(queryFeature, indexFeature);
+    // no break
+  case INSTANCES:
+    // a position below a variable of the query may be anything in
+    // the instance, but not the other way round
+    if(queryFeature==BELOW_VARIABLE) {
+      return true;
+    }
+    if(indexFeature==BELOW_VARIABLE) {
+      return false;
+    }
+    if(queryFeature==VARIABLE) {
+      return indexFeature!=NONEXISTENT;
+    }
+    return queryFeature==indexFeature;
+  case UNIFICATIONS:
+    if(queryFeature==BELOW_VARIABLE || indexFeature==BELOW_VARIABLE) {
+      return true;
+    }
+    if(queryFeature==VARIABLE) {
+      return indexFeature!=NONEXISTENT;
+    }
+    if(indexFeature==VARIABLE) {
+      return queryFeature!=NONEXISTENT;
+    }
+    return queryFeature==indexFeature;
+  }
+  ASSERTION_VIOLATION;
+}
+
+FingerprintIndex::FingerprintIndex()
+: _root(new Node())
+{
+}
+
+FingerprintIndex::~FingerprintIndex()
+{
+  CALL("FingerprintIndex::~FingerprintIndex");
+
+  static Stack<Node*> toDelete;
+  toDelete.reset();
+  toDelete.push(_root);
+  while(toDelete.isNonEmpty()) {
+    Node* n=toDelete.pop();
+    for(unsigned i=0;i<n->children.size();i++) {
+      toDelete.push(n->children[i].child);
+    }
+    delete n;
+  }
+}
+
+void FingerprintIndex::insert(TermList t, Literal* lit, Clause* cls)
+{
+  CALL("FingerprintIndex::insert");
+
+  Node* n=_root;
+  for(unsigned i=0;i<FINGERPRINT_LENGTH;i++) {
+    n=n->getOrCreateChild(feature(t,i));
+  }
+  Entry e;
+  e.t=t;
+  e.lit=lit;
+  e.cls=cls;
+  n->entries.push(e);
+}
+
+void FingerprintIndex::remove(TermList t, Literal* lit, Clause* cls)
+{
+  CALL("FingerprintIndex::remove");
+
+  Node* path[FINGERPRINT_LENGTH+1];
+  unsigned features[FINGERPRINT_LENGTH];
+  path[0]=_root;
+  for(unsigned i=0;i<FINGERPRINT_LENGTH;i++) {
+    features[i]=feature(t,i);
+    path[i+1]=path[i]->child(features[i]);
+    ASS(path[i+1]);
+  }
+
+  Stack<Entry>& entries=path[FINGERPRINT_LENGTH]->entries;
+  for(unsigned i=0;i<entries.size();i++) {
+    Entry& e=entries[i];
+    if(e.t==t && e.lit==lit && e.cls==cls) {
+      e=entries.top();
+      entries.pop();
+      break;
+    }
+  }
+
+  // nodes left without terms below them are removed
+  for(unsigned i=FINGERPRINT_LENGTH;i>0;i--) {
+    Node* n=path[i];
+    if(n->entries.isNonEmpty() || n->children.isNonEmpty()) {
+      break;
+    }
+    path[i-1]->removeChild(features[i-1]);
+    delete n;
+  }
+}
+
+/**
+ * Iterator over the indexed terms whose fingerprints are compatible
+ * with the fingerprint of the query and which pass the full check.
+ */
+class FingerprintIndex::ResultIterator
+: public IteratorCore<TermQueryResult>
+{
+public:
+  CLASS_NAME(FingerprintIndex::ResultIterator);
+  USE_ALLOCATOR(ResultIterator);
+
+  ResultIterator(Node* root, RetrievalMode mode, TermList query, bool retrieveSubstitutions)
+  : _mode(mode), _query(query), _retrieveSubstitutions(retrieveSubstitutions),
+    _leaf(0), _leafIndex(0), _found(0)
+  {
+    CALL("FingerprintIndex::ResultIterator::ResultIterator");
+
+    for(unsigned i=0;i<FINGERPRINT_LENGTH;i++) {
+      _features[i]=feature(query,i);
+    }
+    _states.push(State(root,0));
+  }
+
+  bool hasNext()
+  {
+    CALL("FingerprintIndex::ResultIterator::hasNext");
+
+    if(_found) {
+      return true;
+    }
+    for(;;) {
+      while(_leaf && _leafIndex<_leaf->entries.size()) {
+        Entry* e=&_leaf->entries[_leafIndex++];
+        if(verify(*e)) {
+          _found=e;
+          return true;
+        }
+      }
+      _leaf=0;
+      if(_states.isEmpty()) {
+        return false;
+      }
+      State s=_states.pop();
+      if(s.second==FINGERPRINT_LENGTH) {
+        _leaf=s.first;
+        _leafIndex=0;
+        continue;
+      }
+      expand(s.first, s.second);
+    }
+  }
+
+  TermQueryResult next()
+  {
+    CALL("FingerprintIndex::ResultIterator::next");
+    ASS(_found);
+
+    Entry* e=_found;
+    _found=0;
+    if(!_retrieveSubstitutions) {
+      return TermQueryResult(e->t, e->lit, e->cls);
+    }
+    return TermQueryResult(e->t, e->lit, e->cls,
+        ResultSubstitution::fromSubstitution(&_subst, QUERY_BANK, RESULT_BANK));
+  }
+
+private:
+  static const int QUERY_BANK=0;
+  static const int RESULT_BANK=1;
+
+  /** A node of the trie together with its depth */
+  typedef pair<Node*,unsigned> State;
+
+  bool verify(Entry& e)
+  {
+    CALL("FingerprintIndex::ResultIterator::verify");
+
+    _subst.reset();
+    switch(_mode) {
+    case GENERALIZATIONS:
+      return _subst.match(e.t, RESULT_BANK, _query, QUERY_BANK);
+    case INSTANCES:
+      return _subst.match(_query, QUERY_BANK, e.t, RESULT_BANK);
+    case UNIFICATIONS:
+      return _subst.unify(_query, QUERY_BANK, e.t, RESULT_BANK);
+    }
+    ASSERTION_VIOLATION;
+  }
+
+  void expand(Node* n, unsigned depth)
+  {
+    CALL("FingerprintIndex::ResultIterator::expand");
+
+    unsigned qf=_features[depth];
+    Stack<Edge>& children=n->children;
+    if(qf<FUNCTION) {
+      for(unsigned i=0;i<children.size();i++) {
+        if(compatible(_mode, qf, children[i].feature)) {
+          _states.push(State(children[i].child, depth+1));
+        }
+      }
+      return;
+    }
+    // a function symbol is compatible at most with the same
+    // symbol and with the features that precede all symbols
+    for(unsigned i=0;i<children.size() && children[i].feature<FUNCTION;i++) {
+      if(compatible(_mode, qf, children[i].feature)) {
+        _states.push(State(children[i].child, depth+1));
+      }
+    }
+    Node* c=n->child(qf);
+    if(c) {
+      _states.push(State(c, depth+1));
+    }
+  }
+
+  RetrievalMode _mode;
+  TermList _query;
+  bool _retrieveSubstitutions;
+  unsigned _features[FINGERPRINT_LENGTH];
+  Stack<State> _states;
+
+  Node* _leaf;
+  unsigned _leafIndex;
+  Entry* _found;
+
+  RobSubstitution _subst;
+};
+
+TermQueryResultIterator FingerprintIndex::getResultIterator(RetrievalMode mode, TermList t,
+    bool retrieveSubstitutions)
+{
+  CALL("FingerprintIndex::getResultIterator");
+
+  return vi( new ResultIterator(_root, mode, t, retrieveSubstitutions) );
+}
+
+TermQueryResultIterator FingerprintIndex::getUnifications(TermList t,
+    bool retrieveSubstitutions)
+{
+  return getResultIterator(UNIFICATIONS, t, retrieveSubstitutions);
+}
+
+TermQueryResultIterator FingerprintIndex::getGeneralizations(TermList t,
+    bool retrieveSubstitutions)
+{
+  return getResultIterator(GENERALIZATIONS, t, retrieveSubstitutions);
+}
+
+TermQueryResultIterator FingerprintIndex::getInstances(TermList t,
+    bool retrieveSubstitutions)
+{
+  return getResultIterator(INSTANCES, t, retrieveSubstitutions);
+}
+
+bool FingerprintIndex::generalizationExists(TermList t)
+{
+  CALL("FingerprintIndex::generalizationExists");
+
+  ResultIterator it(_root, GENERALIZATIONS, t, false);
+  return it.hasNext();
+}
+
+}
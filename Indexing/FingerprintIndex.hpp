@@ -0,0 +1,139 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file FingerprintIndex.hpp
+ * Defines class FingerprintIndex.
+ */
+
+#ifndef __FingerprintIndex__
+#define __FingerprintIndex__
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Term.hpp"
+
+#include "Index.hpp"
+#include "TermIndexingStructure.hpp"
+
+namespace Indexing {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * Fingerprint index of terms.
+ *
+ * The fingerprint of a term records what occurs at a fixed set of
+ * positions: a function symbol, a variable, a position below a variable,
+ * or a position that does not exist. Two terms can only be unifiable
+ * (or one an instance of the other) if their fingerprints are compatible
+ * at each position. Fingerprints are stored in a trie and the terms whose
+ * fingerprints are compatible with the query are verified by
+ * a RobSubstitution.
+ */
+class FingerprintIndex
+: public TermIndexingStructure
+{
+public:
+  CLASS_NAME(FingerprintIndex);
+  USE_ALLOCATOR(FingerprintIndex);
+
+  FingerprintIndex();
+  ~FingerprintIndex();
+
+  void insert(TermList t, Literal* lit, Clause* cls) override;
+  void remove(TermList t, Literal* lit, Clause* cls) override;
+
+  TermQueryResultIterator getUnifications(TermList t,
+	  bool retrieveSubstitutions = true) override;
+  TermQueryResultIterator getGeneralizations(TermList t,
+	  bool retrieveSubstitutions = true) override;
+  TermQueryResultIterator getInstances(TermList t,
+	  bool retrieveSubstitutions = true) override;
+
+  bool generalizationExists(TermList t) override;
+
+#if VDEBUG
+  void markTagged() override {}
+#endif
+
+private:
+  enum RetrievalMode {
+    GENERALIZATIONS,
+    INSTANCES,
+    UNIFICATIONS
+  };
+
+  /** Number of positions sampled into a fingerprint */
+  static const unsigned FINGERPRINT_LENGTH=8;
+
+  /**
+   * Features of fingerprints; a function symbol f is represented
+   * by FUNCTION+f.
+   */
+  enum Feature : unsigned {
+    /** the position does not exist in the term */
+    NONEXISTENT = 0,
+    /** there is a variable at the position */
+    VARIABLE = 1,
+    /** the position is below a variable */
+    BELOW_VARIABLE = 2,
+    FUNCTION = 3
+  };
+
+  struct Entry
+  {
+    TermList t;
+    Literal* lit;
+    Clause* cls;
+  };
+
+  struct Node;
+
+  struct Edge
+  {
+    unsigned feature;
+    Node* child;
+  };
+
+  struct Node
+  {
+    CLASS_NAME(FingerprintIndex::Node);
+    USE_ALLOCATOR(Node);
+
+    Node* child(unsigned feature) const;
+    Node* getOrCreateChild(unsigned feature);
+    void removeChild(unsigned feature);
+
+    static unsigned edgeIndex(const Stack<Edge>& edges, unsigned feature);
+
+    /** Children sorted by the feature */
+    Stack<Edge> children;
+    /** Terms with the fingerprint leading to this node, only at the leaves */
+    Stack<Entry> entries;
+  };
+
+  class ResultIterator;
+
+  static unsigned feature(TermList t, unsigned position);
+  static bool compatible(RetrievalMode mode, unsigned queryFeature, unsigned indexFeature);
+
+  TermQueryResultIterator getResultIterator(RetrievalMode mode, TermList t,
+      bool retrieveSubstitutions);
+
+  Node* _root;
+};
+
+};
+
+#endif // __FingerprintIndex__
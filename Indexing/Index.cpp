@@ -13,6 +13,10 @@
  *
  */
 
+#include <algorithm>
+
+#include "Kernel/Clause.hpp"
+
 #include "Index.hpp"
 
 
@@ -25,6 +29,9 @@ using namespace Saturation;
 
 Index::~Index()
 {
+  while(_pendingClauses.isNonEmpty()) {
+    _pendingClauses.pop()->decRefCnt();
+  }
   if(!_addedSD.isEmpty()) {
     ASS(!_removedSD.isEmpty());
     _addedSD->unsubscribe();
@@ -45,4 +52,100 @@ void Index::attachContainer(ClauseContainer* cc)
   _removedSD = cc->removedEvent.subscribe(this,&Index::onRemovedFromContainer);
 }
 
+/**
+ * Start collecting the insertions and removals of clauses, so that they
+ * can be performed together by @b finishBatch.
+ *
+ * Until then, the index must not be queried, as it still contains the
+ * removed clauses and misses the added ones.
+ */
+void Index::startBatch()
+{
+  ASS(!_batching);
+
+  _batching = true;
+}
+
+/**
+ * Perform the insertions and removals collected since the call
+ * to @b startBatch.
+ */
+void Index::finishBatch()
+{
+  ASS(_batching);
+
+  _batching = false;
+  applyPendingClauses();
+}
+
+void Index::onAddedToContainer(Clause* c)
+{
+  if(_batching) {
+    deferClause(c, true);
+    return;
+  }
+  handleClause(c, true);
+}
+
+void Index::onRemovedFromContainer(Clause* c)
+{
+  if(_batching) {
+    deferClause(c, false);
+    return;
+  }
+  handleClause(c, false);
+}
+
+/**
+ * Collect the insertion (if @b adding) or the removal of @b c.
+ *
+ * All pending clauses are of the same kind, so the ones of the other kind
+ * are performed first. This way a clause that is removed and added back
+ * within a batch is handled in the right order.
+ */
+void Index::deferClause(Clause* c, bool adding)
+{
+  if(_pendingClauses.isNonEmpty() && _pendingAdding!=adding) {
+    applyPendingClauses();
+  }
+  _pendingAdding = adding;
+  // the clause must stay alive until the index is updated
+  c->incRefCnt();
+  _pendingClauses.push(c);
+}
+
+/**
+ * Insert @b clauses into the index if @b adding, remove them otherwise.
+ *
+ * The clauses are handled in the order of their numbers, so that clauses
+ * that were inserted close to each other are also handled together.
+ * Indexes whose structures can perform many insertions or removals
+ * more cheaply together override this function.
+ */
+void Index::handleClauses(Stack<Clause*>& clauses, bool adding)
+{
+  std::sort(clauses.begin(), clauses.end(),
+      [](Clause* c1, Clause* c2) { return c1->number() < c2->number(); });
+  Stack<Clause*>::Iterator it(clauses);
+  while(it.hasNext()) {
+    handleClause(it.next(), adding);
+  }
+}
+
+void Index::applyPendingClauses()
+{
+  if(_pendingClauses.isEmpty()) {
+    return;
+  }
+  static Stack<Clause*> clauses;
+  ASS(clauses.isEmpty());
+  clauses.loadFromIterator(Stack<Clause*>::Iterator(_pendingClauses));
+  _pendingClauses.reset();
+
+  handleClauses(clauses, _pendingAdding);
+  while(clauses.isNonEmpty()) {
+    clauses.pop()->decRefCnt();
+  }
+}
+
 }
@@ -19,6 +19,7 @@
 
 #include "Lib/Event.hpp"
 #include "Lib/Exception.hpp"
+#include "Lib/Stack.hpp"
 #include "Lib/VirtualIterator.hpp"
 #include "Saturation/ClauseContainer.hpp"
 #include "ResultSubstitution.hpp"
@@ -120,21 +121,33 @@ public:
   virtual ~Index();
 
   void attachContainer(ClauseContainer* cc);
+
+  void startBatch();
+  void finishBatch();
 protected:
-  Index() {}
+  Index() : _batching(false), _pendingAdding(false) {}
 
-  void onAddedToContainer(Clause* c)
-  { handleClause(c, true); }
-  void onRemovedFromContainer(Clause* c)
-  { handleClause(c, false); }
+  void onAddedToContainer(Clause* c);
+  void onRemovedFromContainer(Clause* c);
 
   virtual void handleClause(Clause* c, bool adding) {}
+  virtual void handleClauses(Stack<Clause*>& clauses, bool adding);
 
   //TODO: postponing index modifications during iteration (methods isBeingIterated() etc...)
 
 private:
+  void deferClause(Clause* c, bool adding);
+  void applyPendingClauses();
+
   SubscriptionData _addedSD;
   SubscriptionData _removedSD;
+
+  /** True if insertions and removals are being collected instead of performed */
+  bool _batching;
+  /** True if the pending clauses are to be inserted, false if to be removed */
+  bool _pendingAdding;
+  /** Clauses added to or removed from the container but not yet from the index */
+  Stack<Clause*> _pendingClauses;
 };
 
 
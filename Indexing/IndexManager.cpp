@@ -19,7 +19,10 @@
 #include "Saturation/SaturationAlgorithm.hpp"
 
 #include "AcyclicityIndex.hpp"
+#include "ClauseVariantIndex.hpp"
 #include "CodeTreeInterfaces.hpp"
+#include "DiscriminationTree.hpp"
+#include "FingerprintIndex.hpp"
 #include "GroundingIndex.hpp"
 #include "LiteralIndex.hpp"
 #include "LiteralSubstitutionTree.hpp"
@@ -31,7 +34,7 @@
 using namespace Lib;
 using namespace Indexing;
 
-IndexManager::IndexManager(SaturationAlgorithm* alg) : _alg(alg), _genLitIndex(0)
+IndexManager::IndexManager(SaturationAlgorithm* alg) : _alg(alg), _batching(false), _genLitIndex(0)
 {
   CALL("IndexManager::IndexManager");
 
@@ -76,6 +79,9 @@ Index* IndexManager::request(IndexType t)
   } else {
     e.index=create(t);
     e.refCnt=1;
+    if(_batching) {
+      e.index->startBatch();
+    }
   }
   _store.set(t,e);
   return e.index;
@@ -130,6 +136,63 @@ void IndexManager::provideIndex(IndexType t, Index* index)
   e.index = index;
   e.refCnt = 1; //reference to 1, so that we never delete the provided index
   _store.set(t,e);
+  if(_batching) {
+    index->startBatch();
+  }
+}
+
+/**
+ * Make all indexes collect the insertions and removals of clauses until
+ * the call to @b finishBatch, which performs them together.
+ *
+ * No index can be queried in between.
+ */
+void IndexManager::startBatch()
+{
+  CALL("IndexManager::startBatch");
+  ASS(!_batching);
+
+  _batching=true;
+  DHMap<IndexType,Entry>::Iterator it(_store);
+  while(it.hasNext()) {
+    it.next().index->startBatch();
+  }
+}
+
+void IndexManager::finishBatch()
+{
+  CALL("IndexManager::finishBatch");
+  ASS(_batching);
+
+  _batching=false;
+  DHMap<IndexType,Entry>::Iterator it(_store);
+  while(it.hasNext()) {
+    it.next().index->finishBatch();
+  }
+}
+
+/**
+ * Create a term indexing structure of the kind @b kind. Substitution
+ * trees are the only structure supporting unification with constraints.
+ */
+static TermIndexingStructure* createTermIndexingStructure(Options::TermIndex kind, bool useConstraints=false)
+{
+  CALL("createTermIndexingStructure");
+
+  if(useConstraints) {
+    return new TermSubstitutionTree(true);
+  }
+  switch(kind) {
+  case Options::TermIndex::SUBSTITUTION_TREE:
+    return new TermSubstitutionTree();
+  case Options::TermIndex::CODE_TREE:
+    return new CodeTreeTIS();
+  case Options::TermIndex::DISCRIMINATION_TREE:
+    return new DiscriminationTree();
+  case Options::TermIndex::FINGERPRINT:
+    return new FingerprintIndex();
+  }
+  ASSERTION_VIOLATION;
 }
 
 Index* IndexManager::create(IndexType t)
@@ -176,7 +239,7 @@ Index* IndexManager::create(IndexType t)
     break;
 
   case SUPERPOSITION_SUBTERM_SUBST_TREE:
-    tis=new TermSubstitutionTree(useConstraints);
+    tis=createTermIndexingStructure(_alg->getOptions().superpositionIndex(), useConstraints);
 #if VDEBUG
     //tis->markTagged();
 #endif
@@ -184,7 +247,7 @@ Index* IndexManager::create(IndexType t)
     isGenerating = true;
     break;
   case SUPERPOSITION_LHS_SUBST_TREE:
-    tis=new TermSubstitutionTree(useConstraints);
+    tis=createTermIndexingStructure(_alg->getOptions().superpositionIndex(), useConstraints);
     res=new SuperpositionLHSIndex(tis, _alg->getOrdering(), _alg->getOptions());
     isGenerating = true;
     break;
@@ -196,13 +259,12 @@ Index* IndexManager::create(IndexType t)
     break;
 
   case DEMODULATION_SUBTERM_SUBST_TREE:
-    tis=new TermSubstitutionTree();
+    tis=createTermIndexingStructure(_alg->getOptions().demodulationSubtermIndex());
     res=new DemodulationSubtermIndex(tis);
     isGenerating = false;
     break;
   case DEMODULATION_LHS_SUBST_TREE:
-//    tis=new TermSubstitutionTree();
-    tis=new CodeTreeTIS();
+    tis=createTermIndexingStructure(_alg->getOptions().demodulationLhsIndex());
     res=new DemodulationLHSIndex(tis, _alg->getOrdering(), _alg->getOptions());
     isGenerating = false;
     break;
@@ -225,6 +287,11 @@ Index* IndexManager::create(IndexType t)
     isGenerating = false;
     break;
 
+  case FW_VARIANT_HASH_INDEX:
+    res = new VariantHashIndex();
+    isGenerating = false;
+    break;
+
   case REWRITE_RULE_SUBST_TREE:
     is=new LiteralSubstitutionTree();
     res=new RewriteRuleIndex(is, _alg->getOrdering());
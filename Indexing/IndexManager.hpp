@@ -47,6 +47,8 @@ enum IndexType {
 
   FSD_SUBST_TREE,
 
+  FW_VARIANT_HASH_INDEX,
+
   REWRITE_RULE_SUBST_TREE,
 
   GLOBAL_SUBSUMPTION_INDEX,
@@ -71,6 +73,9 @@ public:
 
   void provideIndex(IndexType t, Index* index);
 
+  void startBatch();
+  void finishBatch();
+
   LiteralIndexingStructure* getGeneratingLiteralIndexingStructure() { ASS(_genLitIndex); return _genLitIndex; };
 private:
 
@@ -82,6 +87,8 @@ private:
   };
   SaturationAlgorithm* _alg;
   DHMap<IndexType,Entry> _store;
+  /** True if the indexes are collecting insertions and removals of clauses */
+  bool _batching;
 
   LiteralIndexingStructure* _genLitIndex;
 
@@ -79,6 +79,19 @@ void LiteralIndex::handleLiteral(Literal* lit, Clause* cl, bool add)
   }
 }
 
+/**
+ * Let the indexing structure perform the insertions or removals of
+ * literals of @b clauses together.
+ */
+void LiteralIndex::handleClauses(Stack<Clause*>& clauses, bool adding)
+{
+  CALL("LiteralIndex::handleClauses");
+
+  _is->startBatch(adding);
+  Index::handleClauses(clauses, adding);
+  _is->finishBatch();
+}
+
 void GeneratingLiteralIndex::handleClause(Clause* c, bool adding)
 {
   CALL("GeneratingLiteralIndex::handleClause");
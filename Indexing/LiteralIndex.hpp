@@ -53,6 +53,7 @@ protected:
   LiteralIndex(LiteralIndexingStructure* is) : _is(is) {}
 
   void handleLiteral(Literal* lit, Clause* cl, bool add);
+  void handleClauses(Stack<Clause*>& clauses, bool adding) override;
 
   LiteralIndexingStructure* _is;
 };
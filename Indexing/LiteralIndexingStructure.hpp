@@ -28,6 +28,14 @@ public:
   virtual void insert(Literal* lit, Clause* cls) = 0;
   virtual void remove(Literal* lit, Clause* cls) = 0;
 
+  /**
+   * Collect the following insertions (if @b adding) or removals until the
+   * call to @b finishBatch, which performs them together. The structure must
+   * not be queried in between. By default, they are performed immediately.
+   */
+  virtual void startBatch(bool adding) {}
+  virtual void finishBatch() {}
+
   virtual SLQueryResultIterator getAll() { NOT_IMPLEMENTED; }
   virtual SLQueryResultIterator getUnifications(Literal* lit,
 	  bool complementary, bool retrieveSubstitutions = true) { NOT_IMPLEMENTED; }
@@ -48,15 +48,14 @@ void LiteralSubstitutionTree::handleLiteral(Literal* lit, Clause* cls, bool inse
   CALL("LiteralSubstitutionTree::handleLiteral");
 
   Literal* normLit=Renaming::normalize(lit);
+  unsigned rootIndex=getRootNodeIndex(normLit);
 
-  BindingMap svBindings;
-  getBindings(normLit, svBindings);
-  if(insert) {
-    //cout << "Into " << this << " insert " << lit->toString() << endl;
-    SubstitutionTree::insert(&_nodes[getRootNodeIndex(normLit)], svBindings, LeafData(cls, lit));
-  } else {
-    SubstitutionTree::remove(&_nodes[getRootNodeIndex(normLit)], svBindings, LeafData(cls, lit));
+  if(_batching) {
+    ASS_EQ(insert,_batchAdding);
+    _batch.push(BatchEntry(rootIndex, normLit, LeafData(cls, lit)));
+    return;
   }
+  handleNormalized(rootIndex, normLit, LeafData(cls, lit), insert);
 }
 
 SLQueryResultIterator LiteralSubstitutionTree::getUnifications(Literal* lit,
@@ -34,6 +34,9 @@ public:
   void remove(Literal* lit, Clause* cls);
   void handleLiteral(Literal* lit, Clause* cls, bool insert);
 
+  void startBatch(bool adding) override { startCollecting(adding); }
+  void finishBatch() override { applyCollected(); }
+
   SLQueryResultIterator getAll();
 
   SLQueryResultIterator getUnifications(Literal* lit,
@@ -14,6 +14,7 @@
  * @since 16/08/2008 flight Sydney-San Francisco
  */
 
+#include <algorithm>
 #include <utility>
 
 #include "Shell/Options.hpp"
@@ -52,7 +53,7 @@ using namespace Indexing;
  * @since 16/08/2008 flight Sydney-San Francisco
  */
 SubstitutionTree::SubstitutionTree(int nodes,bool useC)
-  : tag(false), _nextVar(0), _nodes(nodes), _useC(useC)
+  : tag(false), _nextVar(0), _nodes(nodes), _useC(useC), _batching(false), _batchAdding(false)
 {
   CALL("SubstitutionTree::SubstitutionTree");
 
@@ -78,6 +79,101 @@ SubstitutionTree::~SubstitutionTree()
   }
 } // SubstitutionTree::~SubstitutionTree
 
+/**
+ * Compare @b t1 and @b t2 by their symbols in pre-order, variables first.
+ *
+ * Sorting terms this way makes the ones sharing a path in the tree
+ * neighbours, so that a batch of insertions or removals visits the
+ * nodes of each path together.
+ */
+bool SubstitutionTree::lessInPreorder(Term* t1, Term* t2)
+{
+  CALL("SubstitutionTree::lessInPreorder");
+
+  static Stack<pair<TermList,TermList> > todo;
+  todo.reset();
+  todo.push(make_pair(TermList(t1),TermList(t2)));
+  while(todo.isNonEmpty()) {
+    pair<TermList,TermList> p=todo.pop();
+    TermList s1=p.first;
+    TermList s2=p.second;
+    if(s1==s2) {
+      continue;
+    }
+    if(s1.isVar() || s2.isVar()) {
+      if(!s1.isVar()) {
+        return false;
+      }
+      if(!s2.isVar()) {
+        return true;
+      }
+      return s1.var()<s2.var();
+    }
+    Term* a1=s1.term();
+    Term* a2=s2.term();
+    if(a1->functor()!=a2->functor()) {
+      return a1->functor()<a2->functor();
+    }
+    for(unsigned i=a1->arity(); i>0; i--) {
+      todo.push(make_pair(*a1->nthArgument(i-1),*a2->nthArgument(i-1)));
+    }
+  }
+  return false;
+} // SubstitutionTree::lessInPreorder
+
+/**
+ * Insert (if @b insert) or remove @b ld with the normalized term or
+ * literal @b normTerm under the root node @b rootIndex.
+ */
+void SubstitutionTree::handleNormalized(unsigned rootIndex, Term* normTerm, LeafData ld, bool insert)
+{
+  CALL("SubstitutionTree::handleNormalized");
+
+  BindingMap svBindings;
+  getBindings(normTerm, svBindings);
+  if(insert) {
+    SubstitutionTree::insert(&_nodes[rootIndex], svBindings, ld);
+  } else {
+    SubstitutionTree::remove(&_nodes[rootIndex], svBindings, ld);
+  }
+} // SubstitutionTree::handleNormalized
+
+/**
+ * Collect the following insertions (if @b adding) or removals in _batch
+ * until the call to @b applyCollected.
+ */
+void SubstitutionTree::startCollecting(bool adding)
+{
+  CALL("SubstitutionTree::startCollecting");
+  ASS(!_batching);
+  ASS(_batch.isEmpty());
+
+  _batching=true;
+  _batchAdding=adding;
+} // SubstitutionTree::startCollecting
+
+/**
+ * Perform the collected insertions or removals, sorted by their root
+ * nodes and terms.
+ */
+void SubstitutionTree::applyCollected()
+{
+  CALL("SubstitutionTree::applyCollected");
+  ASS(_batching);
+
+  _batching=false;
+  std::sort(_batch.begin(), _batch.end(), [](const BatchEntry& e1, const BatchEntry& e2) {
+    if(e1.rootIndex!=e2.rootIndex) {
+      return e1.rootIndex<e2.rootIndex;
+    }
+    return lessInPreorder(e1.normTerm, e2.normTerm);
+  });
+  for(size_t i=0; i<_batch.size(); i++) {
+    handleNormalized(_batch[i].rootIndex, _batch[i].normTerm, _batch[i].ld, _batchAdding);
+  }
+  _batch.reset();
+} // SubstitutionTree::applyCollected
+
 /**
  * Store initial bindings of term @b t into @b bq.
  *
@@ -491,6 +491,28 @@ public:
     virtual Node** childByTop(TermList t, bool canCreate);
     void remove(TermList t);
 
+    /**
+     * Return a key identifying the top symbol of @b t, so that
+     * TermList::sameTop(s,t) iff topKey(s)==topKey(t). Keys of
+     * variables have one of the two lowest bits set, keys of
+     * complex terms have both of them clear.
+     */
+    static size_t topKey(TermList t)
+    { return t.isVar() ? t.content() : (static_cast<size_t>(t.term()->functor()) << 2); }
+    static bool isVarKey(size_t key) { return key & 3; }
+
+    /** Return the index of the child with the same top as @b t, or -1 if there is none */
+    int childIndexByTop(TermList t) const
+    {
+      size_t key = topKey(t);
+      for(int i=0;i<_size;i++) {
+        if(_tops[i]==key) {
+          return i;
+        }
+      }
+      return -1;
+    }
+
 #if VDEBUG
     virtual void assertValid() const
     {
@@ -503,6 +525,9 @@ public:
 
     int _size;
     Node* _nodes[UARR_INTERMEDIATE_NODE_MAX_SIZE+1];
+    /** topKey() of the terms of _nodes, so that a child can be looked up
+     * without dereferencing the children */
+    size_t _tops[UARR_INTERMEDIATE_NODE_MAX_SIZE];
   };
 
   class UArrIntermediateNodeWithSorts
@@ -684,6 +709,28 @@ public:
   /** enable searching with constraints for this tree */
   bool _useC;
 
+  /** Insertion or removal of a normalized term collected during a batch */
+  struct BatchEntry
+  {
+    BatchEntry(unsigned rootIndex, Term* normTerm, LeafData ld)
+    : rootIndex(rootIndex), normTerm(normTerm), ld(ld) {}
+
+    unsigned rootIndex;
+    Term* normTerm;
+    LeafData ld;
+  };
+
+  static bool lessInPreorder(Term* t1, Term* t2);
+  void handleNormalized(unsigned rootIndex, Term* normTerm, LeafData ld, bool insert);
+  void startCollecting(bool adding);
+  void applyCollected();
+
+  /** true if insertions or removals are collected in _batch */
+  bool _batching;
+  /** true if the collected operations are insertions */
+  bool _batchAdding;
+  Stack<BatchEntry> _batch;
+
   class LeafIterator
   : public IteratorCore<Leaf*>
   {
@@ -616,41 +616,28 @@ bool SubstitutionTree::FastGeneralizationsIterator::enterNode(Node*& curr)
   curr=0;
 
   if(currType==UNSORTED_LIST) {
-    Node** nl=static_cast<UArrIntermediateNode*>(inode)->_nodes;
+    UArrIntermediateNode* unode=static_cast<UArrIntermediateNode*>(inode);
+    Node** nl=unode->_nodes;
+    //the top keys let us classify the children without touching them
+    const size_t* tops=unode->_tops;
     if(binding.isTerm()) {
-      unsigned bindingFunctor=binding.term()->functor();
-      //let's first skip proper term nodes at the beginning...
-      while(*nl && (*nl)->term.isTerm()) {
-        //...and have the one that interests us, if we encounter it.
-        if(!curr && (*nl)->term.term()->functor()==bindingFunctor) {
-          curr=*nl;
-        }
-        nl++;
-      }
-      if(!curr && *nl) {
-        //we've encountered a variable node, but we still have to check, whether
-        //the one proper term node, that interests us, isn't here
-        Node** nl2=nl+1;
-        while(*nl2) {
-          if((*nl2)->term.isTerm() && (*nl2)->term.term()->functor()==bindingFunctor) {
-            curr=*nl2;
-            break;
-          }
-          nl2++;
-        }
-      }
-    } else {
-      //let's first skip proper term nodes at the beginning
-      while(*nl && (*nl)->term.isTerm()) {
-        nl++;
+      int idx=unode->childIndexByTop(binding);
+      if(idx!=-1) {
+        curr=nl[idx];
       }
     }
-    if(!curr && *nl) {
-      curr=*(nl++);
-      while(*nl && (*nl)->term.isTerm()) {
-	nl++;
+    //let's skip proper term nodes to get to the first variable node
+    int i=0;
+    while(i<unode->_size && !UArrIntermediateNode::isVarKey(tops[i])) {
+      i++;
+    }
+    if(!curr && i<unode->_size) {
+      curr=nl[i++];
+      while(i<unode->_size && !UArrIntermediateNode::isVarKey(tops[i])) {
+	i++;
       }
     }
+    nl+=i;
     if(curr) {
       _specVarNumbers.push(inode->childVar);
     }
@@ -830,18 +830,13 @@ bool SubstitutionTree::FastInstancesIterator::enterNode(Node*& curr)
     ASS(*nl); //inode is not empty
     bool noAlternatives=false;
     if(query.isTerm()) {
-      unsigned bindingFunctor=query.term()->functor();
-      //let's skip terms that don't have the same top functor...
-      while(*nl && (!(*nl)->term.isTerm() || (*nl)->term.term()->functor()!=bindingFunctor)) {
-        nl++;
-      }
-
-      if(*nl) {
+      int idx=static_cast<UArrIntermediateNode*>(inode)->childIndexByTop(query);
+      if(idx!=-1) {
 	//we've found the term with the same top functor
-	ASS_EQ((*nl)->term.term()->functor(),bindingFunctor);
-        curr=*nl;
-        noAlternatives=true; //there is at most one term with each top functor
+	ASS_EQ(nl[idx]->term.term()->functor(),query.term()->functor());
+        curr=nl[idx];
       }
+      noAlternatives=true; //there is at most one term with each top functor
     } else {
       ASS(query.isVar());
       //everything is matched by a variable
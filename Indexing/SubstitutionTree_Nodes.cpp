@@ -168,15 +168,16 @@ SubstitutionTree::Node** SubstitutionTree::UArrIntermediateNode::
 {
   CALL("SubstitutionTree::UArrIntermediateNode::childByTop");
 
-  for(int i=0;i<_size;i++) {
-    if(TermList::sameTop(t, _nodes[i]->term)) {
-      return &_nodes[i];
-    }
+  int idx=childIndexByTop(t);
+  if(idx!=-1) {
+    ASS(TermList::sameTop(t, _nodes[idx]->term));
+    return &_nodes[idx];
   }
   if(canCreate) {
     mightExistAsTop(t);
     ASS_L(_size,UARR_INTERMEDIATE_NODE_MAX_SIZE);
     ASS_EQ(_nodes[_size],0);
+    _tops[_size]=topKey(t);
     _nodes[++_size]=0;
     return &_nodes[_size-1];
   }
@@ -187,13 +188,13 @@ void SubstitutionTree::UArrIntermediateNode::remove(TermList t)
 {
   CALL("SubstitutionTree::UArrIntermediateNode::remove");
 
-  for(int i=0;i<_size;i++) {
-    if(TermList::sameTop(t, _nodes[i]->term)) {
-      _size--;
-      _nodes[i]=_nodes[_size];
-      _nodes[_size]=0;
-      return;
-    }
+  int idx=childIndexByTop(t);
+  if(idx!=-1) {
+    _size--;
+    _nodes[idx]=_nodes[_size];
+    _tops[idx]=_tops[_size];
+    _nodes[_size]=0;
+    return;
   }
   ASSERTION_VIOLATION;
 }
@@ -12,6 +12,7 @@
  * Implements class TermCodeTree.
  */
 
+#include <algorithm>
 #include <utility>
  
 #include "Lib/BitUtils.hpp"
@@ -102,6 +103,7 @@ void TermCodeTree::remove(const TermInfo& ti)
   }
   
   rtm.op->makeFail();
+  _entryCnt--;
   
   delete rti;
   ft->destroy();
@@ -129,6 +131,68 @@ void TermCodeTree::remove(const TermInfo& ti)
   */
 } // TermCodeTree::remove
 
+/**
+ * Remove all the terms of @b tis. If they are numerous enough, the tree
+ * is traversed only once instead of looking up each term by
+ * a RemovingTermMatcher.
+ */
+void TermCodeTree::remove(Stack<TermInfo*>& tis)
+{
+  CALL("TermCodeTree::remove/batch");
+
+  if(!isSweepCheaper(tis.size())) {
+    Stack<TermInfo*>::Iterator tit(tis);
+    while(tit.hasNext()) {
+      remove(*tit.next());
+    }
+    return;
+  }
+
+  auto less=[](const TermInfo* ti1, const TermInfo* ti2) {
+    if(ti1->cls!=ti2->cls) {
+      return ti1->cls<ti2->cls;
+    }
+    if(ti1->lit!=ti2->lit) {
+      return ti1->lit<ti2->lit;
+    }
+    return ti1->t.content()<ti2->t.content();
+  };
+  std::sort(tis.begin(), tis.end(), less);
+  // the same term can be stored more than once, so each of tis
+  // is marked when a stored term is removed for it
+  static DArray<bool> removed;
+  removed.init(tis.size(), false);
+
+  static Stack<CodeOp*> successOps;
+  successOps.reset();
+  getSuccessOps(successOps);
+
+  size_t removedCnt=0;
+  Stack<CodeOp*>::Iterator sit(successOps);
+  while(sit.hasNext()) {
+    CodeOp* op=sit.next();
+    TermInfo* ti=static_cast<TermInfo*>(op->getSuccessResult());
+    size_t idx=std::lower_bound(tis.begin(), tis.end(), ti, less)-tis.begin();
+    while(idx<tis.size() && removed[idx] && *tis[idx]==*ti) {
+      idx++;
+    }
+    if(idx==tis.size() || *tis[idx]!=*ti) {
+      continue;
+    }
+    removed[idx]=true;
+    removedCnt++;
+    op->makeFail();
+    delete ti;
+  }
+  if(removedCnt!=tis.size()) {
+    ASSERTION_VIOLATION;
+    INVALID_OPERATION("term being removed was not found");
+  }
+  _entryCnt-=removedCnt;
+
+  optimizeMemoryAfterRemovals();
+} // TermCodeTree::remove
+
 void TermCodeTree::RemovingTermMatcher::init(FlatTerm* ft_, 
 					     TermCodeTree* tree_, Stack<CodeOp*>* firstsInBlocks_)
 {
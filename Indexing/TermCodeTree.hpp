@@ -67,6 +67,7 @@ public:
 
   void insert(TermInfo* ti);
   void remove(const TermInfo& ti);
+  void remove(Stack<TermInfo*>& tis);
   
 private:
   struct RemovingTermMatcher
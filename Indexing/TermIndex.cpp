@@ -57,6 +57,18 @@ TermQueryResultIterator TermIndex::getInstances(TermList t,
   return _is->getInstances(t, retrieveSubstitutions);
 }
 
+/**
+ * Let the indexing structure perform the insertions or removals of
+ * terms of @b clauses together.
+ */
+void TermIndex::handleClauses(Stack<Clause*>& clauses, bool adding)
+{
+  CALL("TermIndex::handleClauses");
+
+  _is->startBatch(adding);
+  Index::handleClauses(clauses, adding);
+  _is->finishBatch();
+}
 
 void SuperpositionSubtermIndex::handleClause(Clause* c, bool adding)
 {
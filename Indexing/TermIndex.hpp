@@ -41,6 +41,8 @@ public:
 protected:
   TermIndex(TermIndexingStructure* is) : _is(is) {}
 
+  void handleClauses(Stack<Clause*>& clauses, bool adding) override;
+
   TermIndexingStructure* _is;
 };
 
@@ -27,6 +27,14 @@ public:
   virtual void insert(TermList t, Literal* lit, Clause* cls) = 0;
   virtual void remove(TermList t, Literal* lit, Clause* cls) = 0;
 
+  /**
+   * Collect the following insertions (if @b adding) or removals until the
+   * call to @b finishBatch, which performs them together. The structure must
+   * not be queried in between. By default, they are performed immediately.
+   */
+  virtual void startBatch(bool adding) {}
+  virtual void finishBatch() {}
+
   virtual TermQueryResultIterator getUnifications(TermList t,
 	  bool retrieveSubstitutions = true) { NOT_IMPLEMENTED; }
   virtual TermQueryResultIterator getUnificationsWithConstraints(TermList t,
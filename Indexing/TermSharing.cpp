@@ -91,6 +91,7 @@ Term* TermSharing::insert(Term* t)
    if (s == t) {
     unsigned weight = 1;
     unsigned vars = 0;
+    TermSummary summary = {0, 1};
     bool hasInterpretedConstants=t->arity()==0 &&
 	env.signature->getFunction(t->functor())->interpreted();
     Color color = COLOR_TRANSPARENT;
@@ -99,6 +100,8 @@ Term* TermSharing::insert(Term* t)
           ASS(tt->isOrdinaryVar());
           vars++;
           weight += 1;
+          summary.varMask |= varMaskBit(tt->var());
+          summary.depth = max(summary.depth, 2u);
       }
       else 
       {
@@ -108,6 +111,9 @@ Term* TermSharing::insert(Term* t)
     
           vars += r->vars();
           weight += r->weight();
+          const TermSummary& argSummary = this->summary(r);
+          summary.varMask |= argSummary.varMask;
+          summary.depth = max(summary.depth, argSummary.depth+1);
           if (env.colorUsed) {
               color = static_cast<Color>(color | r->color());
           }
@@ -127,6 +133,8 @@ Term* TermSharing::insert(Term* t)
     }
       
     t->setInterpretedConstantsPresence(hasInterpretedConstants);
+    ASS_EQ(_summaries.size(), _totalTerms);
+    _summaries.push(summary);
     _totalTerms++;
      
     ASS_REP(SortHelper::areImmediateSortsValid(t), t->toString());
@@ -314,6 +322,30 @@ Literal* TermSharing::tryGetOpposite(Literal* l)
   return 0;
 }
 
+/**
+ * Compute and store the number of distinct variables of every shared
+ * term and literal for which it has not been computed yet.
+ *
+ * The value is otherwise computed lazily and written into the term
+ * itself. Calling this in the portfolio parent before the strategies
+ * are forked means the children only ever read these words, so the
+ * pages of the term bank stay shared instead of being copied on write
+ * by every child.
+ */
+void TermSharing::precomputeDistinctVars()
+{
+  CALL("TermSharing::precomputeDistinctVars");
+
+  Set<Term*,TermSharing>::Iterator ts(_terms);
+  while (ts.hasNext()) {
+    ts.next()->getDistinctVars();
+  }
+  Set<Literal*,TermSharing>::Iterator ls(_literals);
+  while (ls.hasNext()) {
+    ls.next()->getDistinctVars();
+  }
+}
+
 /**
  * Return true if t1 is greater than t2 in some arbitrary
  * total ordering.
@@ -18,6 +18,7 @@
 #define __TermSharing__
 
 #include "Lib/Set.hpp"
+#include "Lib/Stack.hpp"
 #include "Kernel/Term.hpp"
 
 #include "Lib/Allocator.hpp"
@@ -44,6 +45,36 @@ public:
 
   Literal* tryGetOpposite(Literal* l);
 
+  void precomputeDistinctVars();
+
+  /**
+   * Data precomputed for each shared term when it is inserted,
+   * stored in a side table indexed by the term id
+   */
+  struct TermSummary {
+    /** bit i is set iff the term contains a variable whose number is i modulo 64 */
+    unsigned long long varMask;
+    /** length of the longest path from the root to a leaf, constants have depth 1 */
+    unsigned depth;
+  };
+
+  /** Return the precomputed summary of a shared term @b t */
+  inline const TermSummary& summary(const Term* t) const
+  {
+    ASS(t->shared());
+    ASS(!t->isLiteral());
+    return _summaries[t->getId()];
+  }
+  /** Return the bit corresponding to the variable @b var in variable masks */
+  inline static unsigned long long varMaskBit(unsigned var)
+  { return 1ull<<(var&63); }
+  /**
+   * Return the variable mask of @b t. A set of variables is contained
+   * in the variables of @b t only if its mask is a subset of this one.
+   */
+  inline unsigned long long varMask(TermList t) const
+  { return t.isVar() ? varMaskBit(t.var()) : summary(t.term()).varMask; }
+
   /** The hash function of this literal */
   inline static unsigned hash(const Literal* l)
   { return l->hash(); }
@@ -73,6 +104,8 @@ private:
   Set<Literal*,TermSharing> _literals;
   /** Number of terms stored */
   unsigned _totalTerms;
+  /** Summaries of shared terms, indexed by term ids */
+  Stack<TermSummary> _summaries;
   /** Number of ground terms stored */
   // unsigned _groundTerms; // MS: unused
   /** Number of literals stored */
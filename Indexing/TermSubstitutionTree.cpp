@@ -69,17 +69,14 @@ void TermSubstitutionTree::handleTerm(TermList t, Literal* lit, Clause* cls, boo
     Term* term=t.term();
 
     Term* normTerm=Renaming::normalize(term);
-
-    BindingMap svBindings;
-    getBindings(normTerm, svBindings);
-
     unsigned rootNodeIndex=getRootNodeIndex(normTerm);
 
-    if(insert) {
-      SubstitutionTree::insert(&_nodes[rootNodeIndex], svBindings, ld);
-    } else {
-      SubstitutionTree::remove(&_nodes[rootNodeIndex], svBindings, ld);
+    if(_batching) {
+      ASS_EQ(insert,_batchAdding);
+      _batch.push(BatchEntry(rootNodeIndex, normTerm, ld));
+      return;
     }
+    handleNormalized(rootNodeIndex, normTerm, ld, insert);
   }
 }
 
@@ -38,6 +38,9 @@ public:
   void insert(TermList t, Literal* lit, Clause* cls);
   void remove(TermList t, Literal* lit, Clause* cls);
 
+  void startBatch(bool adding) override { startCollecting(adding); }
+  void finishBatch() override { applyCollected(); }
+
   bool generalizationExists(TermList t);
 
 
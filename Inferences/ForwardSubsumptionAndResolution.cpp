@@ -13,6 +13,8 @@
  */
 
 
+#include "Debug/RuntimeStatistics.hpp"
+
 #include "Lib/VirtualIterator.hpp"
 #include "Lib/DArray.hpp"
 #include "Lib/List.hpp"
@@ -274,6 +276,7 @@ bool ForwardSubsumptionAndResolution::perform(Clause* cl, Clause*& replacement,
 
   {
   LiteralMiniIndex miniIndex(cl);
+  unsigned long long clSignature=cl->headerSignature();
 
   for(unsigned li=0;li<clen;li++) {
     SLQueryResultIterator rit=_fwIndex->getGeneralizations( (*cl)[li], false, false);
@@ -286,6 +289,13 @@ bool ForwardSubsumptionAndResolution::perform(Clause* cl, Clause*& replacement,
       }
       ASS_G(mcl->length(),1);
 
+      //cheap necessary conditions for mcl to subsume cl; the clause is not marked
+      //as checked, so that subsumption resolution below can still retrieve it
+      if(mcl->length()>clen || (mcl->headerSignature() & ~clSignature)) {
+        RSTAT_CTR_INC("fw subsumption candidates rejected by signature");
+        continue;
+      }
+
       ClauseMatches* cms=new ClauseMatches(mcl);
       mcl->setAux(cms);
       cmStore.push(cms);
@@ -0,0 +1,68 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file ForwardVariantElimination.cpp
+ * Implements class ForwardVariantElimination.
+ */
+
+#include "Lib/Environment.hpp"
+#include "Lib/Metaiterators.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/ColorHelper.hpp"
+
+#include "Indexing/IndexManager.hpp"
+
+#include "Saturation/SaturationAlgorithm.hpp"
+
+#include "Shell/Statistics.hpp"
+
+#include "ForwardVariantElimination.hpp"
+
+namespace Inferences
+{
+
+using namespace Lib;
+using namespace Kernel;
+
+void ForwardVariantElimination::attach(SaturationAlgorithm* salg)
+{
+  CALL("ForwardVariantElimination::attach");
+  ForwardSimplificationEngine::attach(salg);
+  _index=static_cast<VariantHashIndex*>(
+	  _salg->getIndexManager()->request(FW_VARIANT_HASH_INDEX) );
+}
+
+void ForwardVariantElimination::detach()
+{
+  CALL("ForwardVariantElimination::detach");
+  _index=0;
+  _salg->getIndexManager()->release(FW_VARIANT_HASH_INDEX);
+  ForwardSimplificationEngine::detach();
+}
+
+bool ForwardVariantElimination::perform(Clause* cl, Clause*& replacement, ClauseIterator& premises)
+{
+  CALL("ForwardVariantElimination::perform");
+
+  ClauseIterator vit=_index->retrieveVariants(cl);
+  while(vit.hasNext()) {
+    Clause* variant=vit.next();
+    if(variant==cl || !ColorHelper::compatible(cl->color(), variant->color())) {
+      continue;
+    }
+    premises = pvi( getSingletonIterator(variant) );
+    env.statistics->forwardVariantsEliminated++;
+    return true;
+  }
+  return false;
+}
+
+}
@@ -0,0 +1,52 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file ForwardVariantElimination.hpp
+ * Defines class ForwardVariantElimination.
+ */
+
+#ifndef __ForwardVariantElimination__
+#define __ForwardVariantElimination__
+
+#include "Forwards.hpp"
+#include "Indexing/ClauseVariantIndex.hpp"
+
+#include "InferenceEngine.hpp"
+
+namespace Inferences {
+
+using namespace Kernel;
+using namespace Indexing;
+using namespace Saturation;
+
+/**
+ * Deletes clauses that are variants of retained clauses.
+ *
+ * This is subsumed by forward subsumption, but finding variants
+ * by hashing is much cheaper, so duplicates can be removed
+ * even when forward subsumption is off or before it is tried.
+ */
+class ForwardVariantElimination
+: public ForwardSimplificationEngine
+{
+public:
+  CLASS_NAME(ForwardVariantElimination);
+  USE_ALLOCATOR(ForwardVariantElimination);
+
+  void attach(SaturationAlgorithm* salg) override;
+  void detach() override;
+  bool perform(Clause* cl, Clause*& replacement, ClauseIterator& premises) override;
+private:
+  VariantHashIndex* _index;
+};
+
+};
+
+#endif /* __ForwardVariantElimination__ */
@@ -154,11 +154,18 @@ void SLQueryBackwardSubsumption::perform(Clause* cl,
   static DHSet<unsigned> basePreds;
   bool basePredsInit=false;
   bool mustPredInit=false;
-  unsigned mustPred;
+  unsigned mustPred=0;
 
   static DHSet<Clause*> checkedClauses;
   checkedClauses.reset();
 
+  unsigned long long baseSignature=0;
+  for(unsigned bi=0;bi<clen;bi++) {
+    if(bi!=lmIndex) {
+      baseSignature|=Clause::headerSignatureBit((*cl)[bi]->header());
+    }
+  }
+
   SLQueryResultIterator rit=_index->getInstances( (*cl)[lmIndex], false, false);
   while(rit.hasNext()) {
     SLQueryResult qr=rit.next();
@@ -175,9 +182,24 @@ void SLQueryBackwardSubsumption::perform(Clause* cl,
 
     RSTAT_CTR_INC("bs1 0 candidates");
 
+    //every literal header of the base clause (apart from the one matched
+    //to ilit) must occur among the other literals of the instance
+    unsigned long long iSignature=0;
+    for(unsigned ii=0;ii<ilen;ii++) {
+      Literal* l=(*icl)[ii];
+      if(l!=ilit) {
+        iSignature|=Clause::headerSignatureBit(l->header());
+      }
+    }
+    if(baseSignature & ~iSignature) {
+      continue;
+    }
+    RSTAT_CTR_INC("bs1 1 signature survivors");
+
     //here we pick one literal header of the base clause and make sure that
     //every instance clause has it
     if(!mustPredInit) {
+      mustPredInit=true;
       //since the base clause has at least two children, this will always
       //contain an existing literal header after the loop
       mustPred=0;
@@ -205,7 +227,7 @@ void SLQueryBackwardSubsumption::perform(Clause* cl,
     if(!haveMustPred) {
       continue;
     }
-    RSTAT_CTR_INC("bs1 1 mustPred survivors");
+    RSTAT_CTR_INC("bs1 2 mustPred survivors");
 
     //here we check that for every literal header in the base clause
     //there is a literal with the same header in the instance
@@ -242,7 +264,7 @@ void SLQueryBackwardSubsumption::perform(Clause* cl,
       continue;
     }
 
-    RSTAT_CTR_INC("bs1 2 survived");
+    RSTAT_CTR_INC("bs1 3 survived");
 
 
 
@@ -261,11 +283,11 @@ void SLQueryBackwardSubsumption::perform(Clause* cl,
       }
     }
 
-    RSTAT_CTR_INC("bs1 3 final check");
+    RSTAT_CTR_INC("bs1 4 final check");
     if(MLMatcher::canBeMatched(cl,icl,matchedLits.array(),0)) {
       ClauseList::push(icl, subsumed);
       env.statistics->backwardSubsumed++;
-      RSTAT_CTR_INC("bs1 4 performed");
+      RSTAT_CTR_INC("bs1 5 performed");
     }
 
   match_fail:
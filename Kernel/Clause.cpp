@@ -51,6 +51,8 @@ using namespace Saturation;
 using namespace Shell;
 
 size_t Clause::_auxCurrTimestamp = 0;
+bool Clause::_deferDestruction = false;
+const int Clause::MAX_ACTIVE_SPLITS;
 #if VDEBUG
 bool Clause::_auxInUse = false;
 #endif
@@ -64,14 +66,15 @@ Clause::Clause(unsigned length,const Inference& inf)
     _extensionality(false),
     _extensionalityTag(false),
     _component(false),
+    _deferred(false),
     _store(NONE),
     _numSelected(0),
+    _numActiveSplits(0),
     _weight(0),
     _weightForClauseSelection(0),
     _refCnt(0),
     _reductionTimestamp(0),
     _literalPositions(0),
-    _numActiveSplits(0),
     _auxTimestamp(0)
 {
   // MS: TODO: not sure if this belongs here and whether EXTENSIONALITY_AXIOM input types ever appear anywhere (as a vampire-extension TPTP formula role)
@@ -170,6 +173,13 @@ Clause* Clause::fromClause(Clause* c)
   return res;
 }
 
+/** Clauses whose destruction was deferred */
+static Stack<Clause*>& deferredClauses()
+{
+  static Stack<Clause*> deferred(64);
+  return deferred;
+}
+
 bool Clause::shouldBeDestroyed()
 {
   return (_store == NONE) && _refCnt == 0 &&
@@ -179,14 +189,54 @@ bool Clause::shouldBeDestroyed()
 /**
  * If storage is set to NONE, there are no references to this clause,
  * an it is not an input clause, destroy it.
+ *
+ * If deferred destruction is on, the clause is only put aside to be
+ * destroyed by the next call to @b destroyDeferred().
  */
 void Clause::destroyIfUnnecessary()
 {
   if (shouldBeDestroyed()) {
+    if (_deferDestruction) {
+      if (!_deferred) {
+        _deferred = true;
+        deferredClauses().push(this);
+      }
+      return;
+    }
     destroy();
   }
 }
 
+/**
+ * Destroy the clauses whose destruction was deferred and which are
+ * still unnecessary (a clause may have been referenced again since).
+ * Return the number of bytes taken by the destroyed clause objects
+ * and assign their number to @b destroyedCnt.
+ *
+ * The clauses of a single batch are released together, which spares
+ * the allocator the interleaving of frees with the allocations of
+ * the saturation loop.
+ */
+size_t Clause::destroyDeferred(unsigned& destroyedCnt)
+{
+  CALL("Clause::destroyDeferred");
+
+  Stack<Clause*>& deferred = deferredClauses();
+  size_t bytes = 0;
+  destroyedCnt = 0;
+  while (deferred.isNonEmpty()) {
+    Clause* cl = deferred.pop();
+    ASS(cl->_deferred);
+    cl->_deferred = false;
+    if (cl->shouldBeDestroyed()) {
+      bytes += sizeof(Clause) + cl->_length * sizeof(Literal*) - sizeof(Literal*);
+      destroyedCnt++;
+      cl->destroy();
+    }
+  }
+  return bytes;
+}
+
 /**
  * Destroy the clause by deleting the clause itself and all of its
  * literals.
@@ -199,6 +249,7 @@ void Clause::destroy()
   static Stack<Clause*> toDestroy(32);
   Clause* cl = this;
   for(;;) {
+    ASS(!cl->_deferred);
     Inference::Iterator it = cl->_inference.iterator();
     while (cl->_inference.hasNext(it)) {
       Unit* refU = cl->_inference.next(it);
@@ -207,7 +258,8 @@ void Clause::destroy()
       }
       Clause* refCl = static_cast<Clause*> (refU);
       refCl->_refCnt--;
-      if (refCl->shouldBeDestroyed()) {
+      // a deferred clause will be destroyed from the deferred stack
+      if (refCl->shouldBeDestroyed() && !refCl->_deferred) {
         toDestroy.push(refCl);
       }
     }
@@ -687,6 +739,26 @@ unsigned Clause::numPositiveLiterals()
   return count;
 }
 
+/**
+ * Return a bit set of the headers (predicate symbol and polarity) of the
+ * literals of the clause, hashed into 64 bits.
+ *
+ * If the clause subsumes (or is a multi-literal generalization of) a clause D,
+ * each of its headers occurs in D, so its signature is a subset of the
+ * signature of D. This makes for a cheap test that rejects most of the
+ * candidates for subsumption before any matching is done.
+ */
+unsigned long long Clause::headerSignature() const
+{
+  CALL("Clause::headerSignature");
+
+  unsigned long long res = 0;
+  for (unsigned i = 0; i < _length; i++) {
+    res |= headerSignatureBit(_literals[i]->header());
+  }
+  return res;
+}
+
 /**
  * Return index of @b lit in the clause
  *
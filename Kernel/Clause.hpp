@@ -203,6 +203,11 @@ public:
   bool shouldBeDestroyed();
   void destroyIfUnnecessary();
 
+  /** If @b defer is true, clauses that become unnecessary are not destroyed
+   * immediately, but only in the next call to @b destroyDeferred() */
+  static void setDeferredDestruction(bool defer) { _deferDestruction = defer; }
+  static size_t destroyDeferred(unsigned& destroyedCnt);
+
   void incRefCnt() { _refCnt++; }
   void decRefCnt()
   {
@@ -255,10 +260,38 @@ public:
     _inference.setSplits(splits);
   }
   
+  /** the largest absolute value _numActiveSplits can hold */
+  static const int MAX_ACTIVE_SPLITS = (1 << 14) - 1;
+
   int getNumActiveSplits() const { return _numActiveSplits; }
-  void setNumActiveSplits(int newVal) { _numActiveSplits = newVal; }
-  void incNumActiveSplits() { _numActiveSplits++; }
-  void decNumActiveSplits() { _numActiveSplits--; }
+  /**
+   * Set the active splits counter, saturating at MAX_ACTIVE_SPLITS.
+   * A clause with more splits has all of them active when the counter
+   * is back at the saturated value, see allActiveSplits().
+   */
+  void setNumActiveSplits(int newVal)
+  {
+    _numActiveSplits = max(-MAX_ACTIVE_SPLITS, min(newVal, MAX_ACTIVE_SPLITS));
+  }
+  /** Return the value of the counter when all @b splitCnt splits are active */
+  static int allActiveSplits(unsigned splitCnt)
+  { return static_cast<int>(min(splitCnt, static_cast<unsigned>(MAX_ACTIVE_SPLITS))); }
+  void incNumActiveSplits()
+  {
+    ASS_L(_numActiveSplits, MAX_ACTIVE_SPLITS);
+    _numActiveSplits++;
+  }
+  /**
+   * Decrease the counter. It stays at -MAX_ACTIVE_SPLITS rather than
+   * wrapping around, which can only delay the reintroduction of the clause.
+   */
+  void decNumActiveSplits()
+  {
+    ASS_LE(_numActiveSplits, MAX_ACTIVE_SPLITS);
+    if (_numActiveSplits > -MAX_ACTIVE_SPLITS) {
+      _numActiveSplits--;
+    }
+  }
 
   VirtualIterator<vstring> toSimpleClauseStrings();
 
@@ -340,6 +373,11 @@ public:
 
   unsigned numPositiveLiterals(); // number of positive literals in the clause
 
+  /** Return the bit representing the literal header @b header in headerSignature() */
+  static unsigned long long headerSignatureBit(unsigned header)
+  { return 1ull << (header % 64); }
+  unsigned long long headerSignature() const;
+
 protected:
   /** number of literals */
   unsigned _length : 20;
@@ -353,12 +391,21 @@ protected:
   unsigned _extensionalityTag : 1;
   /** Clause is a splitting component. */
   unsigned _component : 1;
+  /** Clause is waiting in the deferred destruction stack */
+  unsigned _deferred : 1;
 
   /** storage class */
   Store _store : 3;
 
-  /** number of selected literals */
-  unsigned _numSelected : 20;
+  /** number of selected literals
+   *
+   * This and the following field are declared 64-bit so that they are packed
+   * with the bit-fields above into a single word, which saves the alignment
+   * padding that an extra 32-bit field would cost in every clause. */
+  unsigned long long _numSelected : 20;
+  /** for splitting: number of splits of the clause that are currently active
+   * (negative once the clause is not worth reintroducing) */
+  long long _numActiveSplits : 15;
 
   /** weight */
   mutable unsigned _weight;
@@ -372,12 +419,11 @@ protected:
   /** a map that translates Literal* to its index in the clause */
   InverseLookup<Literal>* _literalPositions;
 
-  int _numActiveSplits;
-
   size_t _auxTimestamp;
   void* _auxData;
 
   static size_t _auxCurrTimestamp;
+  static bool _deferDestruction;
 #if VDEBUG
   static bool _auxInUse;
 #endif
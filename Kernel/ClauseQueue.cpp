@@ -19,9 +19,7 @@
 #include "Lib/Random.hpp"
 #include "Lib/Environment.hpp"
 
-#if VDEBUG
 #include "Clause.hpp"
-#endif
 
 #include "ClauseQueue.hpp"
 
@@ -30,8 +28,11 @@
 using namespace Lib;
 using namespace Kernel;
 
-ClauseQueue::ClauseQueue()
-    : _height(0)
+ClauseQueue::ClauseQueue(bool useBuckets)
+    : _height(0),
+      _useBuckets(useBuckets),
+      _minBucket(0),
+      _bucketedCnt(0)
 {
   void* mem = ALLOC_KNOWN(sizeof(Node)+MAX_HEIGHT*sizeof(Node*),
           "ClauseQueue::Node");
@@ -46,9 +47,122 @@ ClauseQueue::~ClauseQueue ()
 
   removeAll();
 
+  while (_buckets.isNonEmpty()) {
+    Bucket* b = _buckets.pop();
+    if (b) {
+      ASS(b->isEmpty());
+      delete b;
+    }
+  }
+
   DEALLOC_KNOWN(_left,sizeof(Node)+MAX_HEIGHT*sizeof(Node*),"ClauseQueue::Node");
 } // ClauseQueue::~ClauseQueue
 
+/**
+ * Return the sub-bucket of @b c, creating it (and its bucket) if needed.
+ */
+ClauseQueue::SubBucket* ClauseQueue::getSubBucket(Clause* c)
+{
+  CALL("ClauseQueue::getSubBucket");
+  ASS(_useBuckets);
+
+  unsigned key = bucketKey(c);
+  unsigned long long subKey = subBucketKey(c);
+  unsigned idx = bucketIndex(key);
+  while (_buckets.size() <= idx) {
+    _buckets.push(0);
+  }
+  if (!_buckets[idx]) {
+    _buckets[idx] = new Bucket();
+  }
+  Bucket& b = *_buckets[idx];
+
+  // the sub-buckets are in decreasing order, find the first one not after the keys
+  size_t lo = 0;
+  size_t hi = b.size();
+  while (lo < hi) {
+    size_t mid = (lo+hi)/2;
+    if (b[mid]->after(key,subKey)) {
+      lo = mid+1;
+    }
+    else {
+      hi = mid;
+    }
+  }
+  if (lo < b.size() && b[lo]->key == key && b[lo]->subKey == subKey) {
+    return b[lo];
+  }
+  SubBucket* sb = new SubBucket(key,subKey);
+  b.push(sb);
+  for (size_t i = b.size()-1; i > lo; i--) {
+    b[i] = b[i-1];
+  }
+  b[lo] = sb;
+  return sb;
+} // ClauseQueue::getSubBucket
+
+/**
+ * Remove the clause at position @b pos of the sub-bucket @b sb and delete
+ * the sub-bucket if it becomes empty. The clause must already be removed
+ * from _slots.
+ */
+void ClauseQueue::removeFromSubBucket(SubBucket* sb, size_t pos)
+{
+  CALL("ClauseQueue::removeFromSubBucket");
+  ASS_GE(pos, sb->first);
+  ASS(sb->clauses[pos]);
+
+  sb->clauses[pos] = 0;
+  sb->live--;
+  _bucketedCnt--;
+
+  if (sb->live == 0) {
+    Bucket& b = *_buckets[bucketIndex(sb->key)];
+    // when popping, the sub-bucket is the last one
+    size_t i = b.size()-1;
+    while (b[i] != sb) {
+      ASS_G(i, 0);
+      i--;
+    }
+    for (; i+1 < b.size(); i++) {
+      b[i] = b[i+1];
+    }
+    b.pop();
+    delete sb;
+    return;
+  }
+
+  if (pos == sb->first) {
+    while (!sb->clauses[sb->first]) {
+      sb->first++;
+    }
+  }
+  if (sb->clauses.size() > 2*sb->live+16) {
+    compact(sb);
+  }
+} // ClauseQueue::removeFromSubBucket
+
+/**
+ * Drop the removed clauses from the sub-bucket @b sb.
+ */
+void ClauseQueue::compact(SubBucket* sb)
+{
+  CALL("ClauseQueue::compact");
+
+  size_t live = 0;
+  for (size_t i = sb->first; i < sb->clauses.size(); i++) {
+    Clause* c = sb->clauses[i];
+    if (c) {
+      sb->clauses[live] = c;
+      _slots.get(c).pos = live;
+      live++;
+    }
+  }
+  ASS_EQ(live, sb->live);
+  sb->clauses.truncate(live);
+  sb->first = 0;
+} // ClauseQueue::compact
+
 /**
  * Bind @b v to @b t.
  * @pre @b v must previously be unbound
@@ -57,6 +171,34 @@ void ClauseQueue::insert(Clause* c)
 {
   CALL("ClauseQueue::insert");
 
+  if (_useBuckets) {
+    SubBucket* sb = getSubBucket(c);
+    size_t pos = sb->clauses.size();
+    sb->clauses.push(c);
+    // a clause can be inserted again (e.g., by AVATAR) after newer clauses
+    while (pos > sb->first) {
+      Clause* prev = sb->clauses[pos-1];
+      if (prev && prev->number() < c->number()) {
+        break;
+      }
+      sb->clauses[pos] = prev;
+      if (prev) {
+        _slots.get(prev).pos = pos;
+      }
+      pos--;
+    }
+    sb->clauses[pos] = c;
+    Slot slot = { sb, pos };
+    ALWAYS(_slots.insert(c,slot));
+    sb->live++;
+    _bucketedCnt++;
+    unsigned idx = bucketIndex(sb->key);
+    if (idx < _minBucket || _bucketedCnt == 1) {
+      _minBucket = idx;
+    }
+    return;
+  }
+
   // select a random height between 0 and top
   unsigned h = 0;
   while (Random::getBit()) {
@@ -105,6 +247,15 @@ bool ClauseQueue::remove(Clause* c)
 {
   CALL("ClauseQueue::remove");
 
+  if (_useBuckets) {
+    Slot slot;
+    if (!_slots.pop(c,slot)) {
+      return false;
+    }
+    removeFromSubBucket(slot.subBucket,slot.pos);
+    return true;
+  }
+
   unsigned h = _height;
   Node* left = _left;
 
@@ -161,6 +312,20 @@ bool ClauseQueue::remove(Clause* c)
 Clause* ClauseQueue::pop()
 {
   CALL("ClauseQueue::pop");
+
+  if (_useBuckets) {
+    ASS_G(_bucketedCnt, 0);
+    while (!_buckets[_minBucket] || _buckets[_minBucket]->isEmpty()) {
+      _minBucket++;
+    }
+    SubBucket* sb = _buckets[_minBucket]->top();
+    size_t pos = sb->first;
+    Clause* c = sb->clauses[pos];
+    ALWAYS(_slots.remove(c));
+    removeFromSubBucket(sb,pos);
+    return c;
+  }
+
   ASS(_height >= 0);
   ASS(_left->nodes[0] != 0);
 
@@ -193,6 +358,22 @@ void ClauseQueue::removeAll()
 {
   CALL("ClauseQueue::removeAll");
 
+  if (_useBuckets) {
+    Stack<Bucket*>::Iterator bit(_buckets);
+    while (bit.hasNext()) {
+      Bucket* b = bit.next();
+      if (b) {
+        while (b->isNonEmpty()) {
+          delete b->pop();
+        }
+      }
+    }
+    _slots.reset();
+    _minBucket = 0;
+    _bucketedCnt = 0;
+    return;
+  }
+
   while (_left->nodes[0]) {
     pop();
   }
@@ -201,6 +382,13 @@ void ClauseQueue::removeAll()
 #if VDEBUG
 void ClauseQueue::output(ostream& str) const
 {
+  if (_useBuckets) {
+    Iterator it(const_cast<ClauseQueue&>(*this));
+    while (it.hasNext()) {
+      str << it.next()->toString() << '\n';
+    }
+    return;
+  }
   for (const Node* node = _left->nodes[0]; node; node=node->nodes[0]) {
     str << node->clause->toString() << '\n';
   }
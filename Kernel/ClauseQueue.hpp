@@ -24,7 +24,10 @@ using namespace std;
 
 #include "Debug/Assertion.hpp"
 
+#include "Lib/Allocator.hpp"
+#include "Lib/DHMap.hpp"
 #include "Lib/Reflection.hpp"
+#include "Lib/Stack.hpp"
 
 namespace Kernel {
 
@@ -33,12 +36,22 @@ class Clause;
 /**
  * A clause queue organised as a skip list. The comparison of elements
  * is made using the virtual function compare.
+ *
+ * If created with @b useBuckets, the queue is instead organised as an
+ * array of buckets indexed by the small integer returned by bucketKey(),
+ * which must be the primary key of the order given by lessThan().
+ * Each bucket is split into sub-buckets by subBucketKey(), the secondary
+ * key of the order. Clauses of a sub-bucket only differ in their numbers,
+ * and since newer clauses have larger numbers, a sub-bucket is a FIFO
+ * array to which clauses are appended. Removed clauses are replaced by 0
+ * and their position is kept in a map, so that remove and pop take
+ * constant time, and insert only searches the sub-buckets of its bucket.
  * @since 30/12/2007 Manchester
  */
 class ClauseQueue
 {
 public:
-  ClauseQueue();
+  ClauseQueue(bool useBuckets=false);
   virtual ~ClauseQueue();
   void insert(Clause*);
   bool remove(Clause*);
@@ -46,7 +59,7 @@ public:
   Clause* pop();
   /** True if the queue is empty */
   bool isEmpty() const
-  { return _left->nodes[0] == 0; }
+  { return _useBuckets ? _bucketedCnt == 0 : _left->nodes[0] == 0; }
 #if VDEBUG
   void output(ostream&) const;
 #endif
@@ -55,6 +68,18 @@ public:
 protected:
   /** comparison of clauses */
   virtual bool lessThan(Clause*,Clause*) = 0;
+  /**
+   * The primary key of the order given by lessThan, i.e., if
+   * bucketKey(c1) < bucketKey(c2), then lessThan(c1,c2) must hold.
+   * Only used (and must be overridden) if the queue uses buckets.
+   */
+  virtual unsigned bucketKey(Clause*) { ASSERTION_VIOLATION; }
+  /**
+   * The secondary key of the order given by lessThan. Clauses with the
+   * same bucketKey() and subBucketKey() must be ordered by their numbers.
+   * Only used (and must be overridden) if the queue uses buckets.
+   */
+  virtual unsigned long long subBucketKey(Clause*) { ASSERTION_VIOLATION; }
   /** Nodes in the skip list */
   class Node {
   public:
@@ -68,6 +93,54 @@ protected:
   /** the leftmost node with the dummy key and value */
   Node* _left;
 
+  /** Clauses with the same bucketKey() and subBucketKey() */
+  struct SubBucket {
+    CLASS_NAME(ClauseQueue::SubBucket);
+    USE_ALLOCATOR(ClauseQueue::SubBucket);
+
+    SubBucket(unsigned key, unsigned long long subKey)
+      : key(key), subKey(subKey), first(0), live(0) {}
+    /** true if this sub-bucket comes after the one with keys @b k and @b sk */
+    bool after(unsigned k, unsigned long long sk) const
+    { return key > k || (key == k && subKey > sk); }
+
+    unsigned key;
+    unsigned long long subKey;
+    /** clauses in increasing order, removed ones are replaced by 0 */
+    Stack<Clause*> clauses;
+    /** position of the first clause that was not removed */
+    size_t first;
+    /** number of clauses that were not removed */
+    size_t live;
+  };
+  /** Non-empty sub-buckets in decreasing order, the smallest one is at the end */
+  typedef Stack<SubBucket*> Bucket;
+  /** Position of a clause in the queue */
+  struct Slot {
+    SubBucket* subBucket;
+    size_t pos;
+  };
+  /** keys larger than this share the last bucket */
+  static const unsigned MAX_BUCKET_KEY = 1u << 16;
+
+  /** index of the bucket for the key @b key */
+  static unsigned bucketIndex(unsigned key)
+  { return key < MAX_BUCKET_KEY ? key : MAX_BUCKET_KEY; }
+  SubBucket* getSubBucket(Clause* c);
+  void removeFromSubBucket(SubBucket* sb, size_t pos);
+  void compact(SubBucket* sb);
+
+  /** true if the queue is organised in buckets instead of a skip list */
+  bool _useBuckets;
+  /** buckets indexed by bucketKey(), allocated on demand */
+  Stack<Bucket*> _buckets;
+  /** positions of the clauses in the buckets */
+  DHMap<Clause*, Slot> _slots;
+  /** all buckets below this index are empty */
+  unsigned _minBucket;
+  /** number of clauses in the buckets */
+  unsigned _bucketedCnt;
+
 public:
   /** Iterator over the queue
    * @since 04/01/2008 flight Manchester-Murcia
@@ -78,21 +151,66 @@ public:
 
     /** Create a new iterator */
     inline explicit Iterator(ClauseQueue& queue)
-      : _current(queue._left)
-    {}
+      : _queue(&queue), _current(queue._left), _bucket(queue._minBucket),
+        _subRemaining(0), _subBucket(0), _pos(0)
+    {
+      if (queue._useBuckets && _bucket < queue._buckets.size() && queue._buckets[_bucket]) {
+        _subRemaining = queue._buckets[_bucket]->size();
+      }
+    }
     /** true if there is a next clause */
-    inline bool hasNext() const
-    { return _current->nodes[0]; }
+    inline bool hasNext()
+    {
+      if (!_queue->_useBuckets) {
+        return _current->nodes[0];
+      }
+      for (;;) {
+        if (_subBucket) {
+          while (_pos < _subBucket->clauses.size()) {
+            if (_subBucket->clauses[_pos]) {
+              return true;
+            }
+            _pos++;
+          }
+          _subBucket = 0;
+        }
+        if (_subRemaining) {
+          _subBucket = (*_queue->_buckets[_bucket])[--_subRemaining];
+          _pos = _subBucket->first;
+          continue;
+        }
+        if (_bucket+1 >= _queue->_buckets.size()) {
+          return false;
+        }
+        _bucket++;
+        Bucket* b = _queue->_buckets[_bucket];
+        _subRemaining = b ? b->size() : 0;
+      }
+    }
     /** return the next clause */
     inline Clause* next()
     {
+      if (_queue->_useBuckets) {
+        ALWAYS(hasNext());
+        return _subBucket->clauses[_pos++];
+      }
       _current = _current->nodes[0];
       ASS(_current);
       return _current->clause;
     }
   private:
+    /** The iterated queue */
+    ClauseQueue* _queue;
     /** Current node */
     Node* _current;
+    /** Current bucket, if the queue uses buckets */
+    unsigned _bucket;
+    /** Number of sub-buckets of the current bucket not visited yet */
+    size_t _subRemaining;
+    /** Current sub-bucket */
+    SubBucket* _subBucket;
+    /** Position of the next clause in the current sub-bucket */
+    size_t _pos;
   }; // class ClauseQueue::Iterator
 
 //  class DelIterator {
@@ -643,6 +643,14 @@ Ordering::Result KBO::compare(TermList tl1, TermList tl2) const
   Term* t1=tl1.term();
   Term* t2=tl2.term();
 
+  if(incomparableByVariables(t1,t2)) {
+    return INCOMPARABLE;
+  }
+  Result res;
+  if(findCachedComparison(t1,t2,res)) {
+    return res;
+  }
+
   ASS(_state);
   State* state=_state;
 #if VDEBUG
@@ -657,10 +665,11 @@ Ordering::Result KBO::compare(TermList tl1, TermList tl2) const
     state->traverse(tl1,1);
     state->traverse(tl2,-1);
   }
-  Result res=state->result(t1,t2);
+  res=state->result(t1,t2);
 #if VDEBUG
   _state=state;
 #endif
+  cacheComparison(t1,t2,res);
   return res;
 }
 
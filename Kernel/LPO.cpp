@@ -73,7 +73,20 @@ Ordering::Result LPO::compare(TermList tl1, TermList tl2) const
     return tl2.containsSubterm(tl1) ? LESS : INCOMPARABLE;
   }
   ASS(tl1.isTerm());
-  return clpo(tl1.term(), tl2);
+  if(!tl2.isTerm()) {
+    return clpo(tl1.term(), tl2);
+  }
+
+  if(incomparableByVariables(tl1.term(), tl2.term())) {
+    return INCOMPARABLE;
+  }
+  Result res;
+  if(findCachedComparison(tl1.term(), tl2.term(), res)) {
+    return res;
+  }
+  res=clpo(tl1.term(), tl2);
+  cacheComparison(tl1.term(), tl2.term(), res);
+  return res;
 }
 
 Ordering::Result LPO::clpo(Term* t1, TermList tl2) const
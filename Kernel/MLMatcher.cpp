@@ -64,7 +64,48 @@ private:
   UUMap& _v2pos;
 };
 
-bool createLiteralBindings(Literal* baseLit, LiteralList const* alts, Clause* instCl, Literal* resolvedLit,
+/**
+ * Positions of the literals of the instance clause.
+ *
+ * Unlike Clause::getLiteralPosition(), this does not leave an inverse lookup
+ * object behind in every instance clause longer than three literals (which,
+ * in backward subsumption, would be most of the candidate clauses); instead
+ * the map owned by the matcher is refilled, at most once per match problem.
+ */
+class InstancePositions
+{
+public:
+  void reset(Clause* instance)
+  {
+    _instance=instance;
+    _filled=false;
+  }
+
+  unsigned get(Literal* lit)
+  {
+    CALL("InstancePositions::get");
+
+    if(_instance->length()<=3) {
+      return _instance->getLiteralPosition(lit);
+    }
+    if(!_filled) {
+      _filled=true;
+      _positions.reset();
+      unsigned len=_instance->length();
+      for(unsigned i=0;i<len;i++) {
+        ALWAYS(_positions.insert((*_instance)[i], i));
+      }
+    }
+    return _positions.get(lit);
+  }
+
+private:
+  Clause* _instance;
+  bool _filled;
+  DHMap<Literal*,unsigned,PtrIdentityHash> _positions;
+};
+
+bool createLiteralBindings(Literal* baseLit, LiteralList const* alts, InstancePositions& instPositions, Literal* resolvedLit,
     unsigned*& boundVarData, TermList**& altBindingPtrs, TermList*& altBindingData)
 {
   CALL("createLiteralBindings");
@@ -112,7 +153,7 @@ bool createLiteralBindings(Literal* baseLit, LiteralList const* alts, Clause* in
 	  new(altBindingData++) TermList((size_t)0);
 	} else {
           // add index of the literal in instance clause at the end of the binding sequence
-	  new(altBindingData++) TermList((size_t)instCl->getLiteralPosition(alit));
+	  new(altBindingData++) TermList((size_t)instPositions.get(alit));
 	}
       }
       if(MatchingUtils::matchReversedArgs(baseLit, alit)) {
@@ -127,7 +168,7 @@ bool createLiteralBindings(Literal* baseLit, LiteralList const* alts, Clause* in
 	  new(altBindingData++) TermList((size_t)0);
 	} else {
           // add index of the literal in instance clause at the end of the binding sequence
-	  new(altBindingData++) TermList((size_t)instCl->getLiteralPosition(alit));
+	  new(altBindingData++) TermList((size_t)instPositions.get(alit));
 	}
       }
 
@@ -144,7 +185,7 @@ bool createLiteralBindings(Literal* baseLit, LiteralList const* alts, Clause* in
         new(altBindingData++) TermList((size_t)0);
       } else {
         // add index of the literal in instance clause at the end of the binding sequence
-        new(altBindingData++) TermList((size_t)instCl->getLiteralPosition(alit));
+        new(altBindingData++) TermList((size_t)instPositions.get(alit));
       }
     }
   }
@@ -193,6 +234,7 @@ struct MatchingData {
   LiteralList const* const* alts;
   Clause* instance;
   Literal* resolvedLit;
+  InstancePositions* instancePositions;
 
   unsigned* boundVarNumStorage;
   TermList** altBindingPtrStorage;
@@ -320,7 +362,7 @@ struct MatchingData {
     if(!isInitialized(bIndex)) {
       boundVarNums[bIndex]=boundVarNumStorage;
       altBindings[bIndex]=altBindingPtrStorage;
-      ALWAYS(createLiteralBindings(bases[bIndex], alts[bIndex], instance, resolvedLit,
+      ALWAYS(createLiteralBindings(bases[bIndex], alts[bIndex], *instancePositions, resolvedLit,
 	  boundVarNumStorage, altBindingPtrStorage, altBindingStorage));
       varCnts[bIndex]=boundVarNumStorage-boundVarNums[bIndex];
 
@@ -407,11 +449,14 @@ class MLMatcher::Impl final
     DArray<TermList*> s_altBindingPtrs;
     DArray<TermList> s_altBindingsData;
     DArray<pair<int,int> > s_intersectionData;
+    InstancePositions s_instancePositions;
 
     MatchingData s_matchingData;
 
     // For backtracking support
     DArray<unsigned> s_matchRecord;
+    // For each base literal, the index of the match record it has claimed (or 0xFFFFFFFF)
+    DArray<unsigned> s_claimedRecord;
     unsigned s_currBLit;
     int s_counter;
     bool s_multiset;
@@ -432,6 +477,7 @@ MLMatcher::Impl::Impl()
   , s_altBindingsData(256)
   , s_intersectionData(128)
   , s_matchRecord(32)
+  , s_claimedRecord(32)
 { }
 
 
@@ -539,6 +585,8 @@ void MLMatcher::Impl::initMatchingData(Literal** baseLits0, unsigned baseLen, Cl
   s_matchingData.alts=s_altsArr.array();
   s_matchingData.instance=instance;
   s_matchingData.resolvedLit=resolvedLit;
+  s_instancePositions.reset(instance);
+  s_matchingData.instancePositions=&s_instancePositions;
 
   s_matchingData.boundVarNumStorage=s_boundVarNumData.array();
   s_matchingData.altBindingPtrStorage=s_altBindingPtrs.array();
@@ -573,6 +621,7 @@ void MLMatcher::Impl::init(Literal** baseLits, unsigned baseLen, Clause* instanc
   //   This means it is only necessary for multiset matching (because each instance literal can only be used once for matching).
   //   (Except when resolvedLit is set... then there's only two match records??)
   ASS_EQ(s_matchRecord.size(), matchRecordLen);
+  s_claimedRecord.init(baseLen, 0xFFFFFFFF);
 
   s_matchingData.nextAlts[0] = 0;
   s_currBLit = 0;
@@ -614,14 +663,22 @@ bool MLMatcher::Impl::nextMatch()
     if (md->nextAlts[s_currBLit] < maxAlt) {
       // Got a suitable alternative in nextAlt
       unsigned matchRecordIndex=md->getAltRecordIndex(s_currBLit, md->nextAlts[s_currBLit]);
+      // release the record claimed by the previous alternative of currBLit
+      // (a base literal holds at most one record at a time)
+      unsigned prevClaimed = s_claimedRecord[s_currBLit];
+      if (prevClaimed != 0xFFFFFFFF && s_matchRecord[prevClaimed] == s_currBLit) {
+        s_matchRecord[prevClaimed]=0xFFFFFFFF;
+      }
+      s_claimedRecord[s_currBLit]=0xFFFFFFFF;
+#if VDEBUG
       for (unsigned i = 0; i < s_matchRecord.size(); i++) {
-        if (s_matchRecord[i] == s_currBLit) {
-          s_matchRecord[i]=0xFFFFFFFF;
-        }
+        ASS_NEQ(s_matchRecord[i], s_currBLit);
       }
+#endif
       ASS(!s_multiset || s_matchRecord[matchRecordIndex]>s_currBLit);  // when multiset matching, the match record cannot be set already
       if (s_matchRecord[matchRecordIndex]>s_currBLit) {
         s_matchRecord[matchRecordIndex]=s_currBLit;
+        s_claimedRecord[s_currBLit]=matchRecordIndex;
       }
       md->nextAlts[s_currBLit]++;
       s_currBLit++;
@@ -28,6 +28,7 @@
 #include "Lib/Random.hpp"
 
 #include "Shell/Options.hpp"
+#include "Shell/Statistics.hpp"
 #include "Shell/Property.hpp"
 
 #include "LPO.hpp"
@@ -320,6 +321,75 @@ int PrecedenceOrdering::predicateLevel (unsigned pred) const
   }
 } // PrecedenceOrdering::predicateLevel
 
+/**
+ * Return true if each of @b t1 and @b t2 contains a variable that does
+ * not occur in the other one, which makes them incomparable in any
+ * simplification ordering. Only the precomputed variable masks of shared
+ * terms are inspected, so a false result does not mean comparability.
+ */
+bool PrecedenceOrdering::incomparableByVariables(Term* t1, Term* t2)
+{
+  CALL("PrecedenceOrdering::incomparableByVariables");
+
+  if(!t1->shared() || !t2->shared()) {
+    return false;
+  }
+  unsigned long long mask1=env.sharing->summary(t1).varMask;
+  unsigned long long mask2=env.sharing->summary(t2).varMask;
+  return (mask1&~mask2) && (mask2&~mask1);
+}
+
+/**
+ * If the result of comparing shared terms @b t1 and @b t2 is in the
+ * comparison cache, assign it to @b res and return true.
+ */
+bool PrecedenceOrdering::findCachedComparison(Term* t1, Term* t2, Result& res) const
+{
+  CALL("PrecedenceOrdering::findCachedComparison");
+
+  if(!_comparisonCacheMask || !t1->shared() || !t2->shared()) {
+    return false;
+  }
+  env.statistics->orderingCacheLookups++;
+  unsigned id1=t1->getId();
+  unsigned id2=t2->getId();
+  bool swapped=id1>id2;
+  if(swapped) {
+    swap(id1,id2);
+  }
+  const CachedComparison& e=_comparisonCache[comparisonCacheIndex(id1,id2)];
+  if(e.id1!=id1 || e.id2!=id2) {
+    return false;
+  }
+  env.statistics->orderingCacheHits++;
+  res=swapped ? reverse(e.result) : e.result;
+  return true;
+}
+
+/**
+ * Store @b res as the result of comparing @b t1 and @b t2 in the comparison
+ * cache, overwriting whatever was stored in its slot before.
+ */
+void PrecedenceOrdering::cacheComparison(Term* t1, Term* t2, Result res) const
+{
+  CALL("PrecedenceOrdering::cacheComparison");
+
+  if(!_comparisonCacheMask || !t1->shared() || !t2->shared()) {
+    return;
+  }
+  unsigned id1=t1->getId();
+  unsigned id2=t2->getId();
+  ASS_NEQ(id1,id2);
+  if(id1>id2) {
+    swap(id1,id2);
+    res=reverse(res);
+  }
+  CachedComparison& e=_comparisonCache[comparisonCacheIndex(id1,id2)];
+  e.id1=id1;
+  e.id2=id2;
+  e.result=res;
+}
+
 
 /**
  * Return the predicate precedence. If @b pred is less than or equal to
@@ -682,7 +752,8 @@ PrecedenceOrdering::PrecedenceOrdering(const DArray<int>& funcPrec, const DArray
     _predicateLevels(predLevels),
     _predicatePrecedences(predPrec),
     _functionPrecedences(funcPrec),
-    _reverseLCM(reverseLCM)
+    _reverseLCM(reverseLCM),
+    _comparisonCacheMask(0)
 {
   CALL("PrecedenceOrdering::PrecedenceOrdering(const DArray<int>&, const DArray<int>&, const DArray<int>&, bool)");
   ASS_EQ(env.signature->predicates(), _predicates);
@@ -720,6 +791,12 @@ PrecedenceOrdering::PrecedenceOrdering(Problem& prb, const Options& opt)
 {
   CALL("PrecedenceOrdering::PrecedenceOrdering(Problem&,const Options&)");
   ASS_G(_predicates, 0);
+
+  if(opt.orderingComparisonCache()) {
+    unsigned size=1u<<opt.orderingComparisonCache();
+    _comparisonCache.init(size,CachedComparison{0,0,INCOMPARABLE});
+    _comparisonCacheMask=size-1;
+  }
 }
 
 DArray<int> PrecedenceOrdering::funcPrecFromOpts(Problem& prb, const Options& opt) {
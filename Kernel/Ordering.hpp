@@ -178,6 +178,10 @@ protected:
   int predicatePrecedence(unsigned pred) const;
   int predicateLevel(unsigned pred) const;
 
+  static bool incomparableByVariables(Term* t1, Term* t2);
+  bool findCachedComparison(Term* t1, Term* t2, Result& res) const;
+  void cacheComparison(Term* t1, Term* t2, Result res) const;
+
   /** number of predicates in the signature at the time the order was created */
   unsigned _predicates;
   /** number of functions in the signature at the time the order was created */
@@ -190,6 +194,28 @@ protected:
   DArray<int> _functionPrecedences;
 
   bool _reverseLCM;
+
+private:
+  /**
+   * Entry of the comparison cache; the term with the smaller id
+   * is stored as the first one. An entry with both ids zero is empty,
+   * as no term is compared with itself through the cache.
+   */
+  struct CachedComparison {
+    unsigned id1;
+    unsigned id2;
+    Result result;
+  };
+
+  unsigned comparisonCacheIndex(unsigned id1, unsigned id2) const
+  { return ((id1*0x9E3779B1u)^id2)&_comparisonCacheMask; }
+
+  /**
+   * Direct-mapped cache of the results of comparisons of shared terms,
+   * indexed by a hash of their ids. Empty if caching is disabled.
+   */
+  mutable DArray<CachedComparison> _comparisonCache;
+  unsigned _comparisonCacheMask;
 };
 
 }
@@ -54,6 +54,134 @@ using namespace Lib;
 const int RobSubstitution::SPECIAL_INDEX=-2;
 const int RobSubstitution::UNBOUND_INDEX=-1;
 
+RobSubstitution::~RobSubstitution()
+{
+  CALL("RobSubstitution::~RobSubstitution");
+
+  while(_banks.isNonEmpty()) {
+    Bank* bank=_banks.pop();
+    if(bank) {
+      delete bank;
+    }
+  }
+}
+
+void RobSubstitution::reset()
+{
+  CALL("RobSubstitution::reset");
+
+  _stamp++;
+  if(!_stamp) {
+    // the stamps wrapped around, so old bindings could become valid again
+    for(unsigned i=0;i<_banks.size();i++) {
+      Bank* bank=_banks[i];
+      if(bank) {
+        for(unsigned j=0;j<bank->size();j++) {
+          (*bank)[j].stamp=0;
+        }
+      }
+    }
+    _stamp=1;
+  }
+  _trail.reset();
+  //_nextAuxAvailable=0;
+  _nextUnboundAvailable=0;
+}
+
+/**
+ * If @b v is bound, assign its binding to @b binding and return true.
+ * Otherwise return false.
+ */
+bool RobSubstitution::findBinding(const VarSpec& v, TermSpec& binding) const
+{
+  ASS_GE(v.index, SPECIAL_INDEX);
+
+  unsigned bankIdx=v.index-SPECIAL_INDEX;
+  if(bankIdx>=_banks.size() || !_banks[bankIdx]) {
+    return false;
+  }
+  Bank& bank=*_banks[bankIdx];
+  if(v.var>=bank.size() || bank[v.var].stamp!=_stamp) {
+    return false;
+  }
+  binding=bank[v.var].binding;
+  return true;
+}
+
+/**
+ * Bind @b v to @b binding, or make it unbound if @b binding is empty.
+ * The change is not recorded anywhere.
+ */
+void RobSubstitution::setBinding(const VarSpec& v, const TermSpec& binding)
+{
+  CALL("RobSubstitution::setBinding");
+  ASS_GE(v.index, SPECIAL_INDEX);
+
+  unsigned bankIdx=v.index-SPECIAL_INDEX;
+  while(bankIdx>=_banks.size()) {
+    _banks.push(0);
+  }
+  if(!_banks[bankIdx]) {
+    _banks[bankIdx]=new Bank();
+  }
+  Bank& bank=*_banks[bankIdx];
+  if(v.var>=bank.size()) {
+    bank.expand(v.var+1);
+  }
+  BankEntry& e=bank[v.var];
+  if(binding.term.isEmpty()) {
+    e.stamp=0;
+  } else {
+    e.binding=binding;
+    e.stamp=_stamp;
+  }
+}
+
+/**
+ * Undo the changes recorded on the trail above @b mark.
+ */
+void RobSubstitution::undoTrail(unsigned mark)
+{
+  CALL("RobSubstitution::undoTrail");
+
+  while(_trail.size()>mark) {
+    TrailEntry e=_trail.pop();
+    setBinding(e.var, e.previous);
+  }
+}
+
+/**
+ * Finish a unification or matching whose bindings were put on the trail
+ * above @b mark.
+ *
+ * If it failed, the bindings are undone. Otherwise, if the outermost
+ * scope is being closed, the bindings are either made permanent, or, when
+ * changes are being recorded, a single backtrack object undoing all of
+ * them is added to the BacktrackData.
+ */
+void RobSubstitution::closeUndoScope(unsigned mark, bool success)
+{
+  CALL("RobSubstitution::closeUndoScope");
+  ASS_G(_undoScopeDepth,0);
+
+  _undoScopeDepth--;
+  if(!success) {
+    undoTrail(mark);
+    return;
+  }
+  if(_undoScopeDepth) {
+    // the enclosing scope takes care of the bindings
+    return;
+  }
+  if(bdIsRecording()) {
+    if(_trail.size()>mark) {
+      bdAdd(new TrailBacktrackObject(this, mark));
+    }
+  } else {
+    _trail.truncate(mark);
+  }
+}
+
 /**
  * Unify @b t1 and @b t2, and return true iff it was successful.
  */
@@ -118,7 +246,8 @@ void RobSubstitution::denormalize(const Renaming& normalizer, int normalIndex, i
     Renaming::Item itm=nit.next();
     VarSpec normal(itm.second, normalIndex);
     VarSpec denormalized(itm.first, denormalizedIndex);
-    ASS(!_bank.find(denormalized));
+    DEBUG_CODE(TermSpec aux;)
+    ASS(!findBinding(denormalized,aux));
     bindVar(denormalized,normal);
   }
 }
@@ -128,7 +257,7 @@ bool RobSubstitution::isUnbound(VarSpec v) const
   CALL("RobSubstitution::isUnbound");
   for(;;) {
     TermSpec binding;
-    bool found=_bank.find(v,binding);
+    bool found=findBinding(v,binding);
     if(!found || binding.index==UNBOUND_INDEX) {
       return true;
     } else if(binding.term.isTerm()) {
@@ -148,7 +277,7 @@ TermList RobSubstitution::getSpecialVarTop(unsigned specialVar) const
   VarSpec v(specialVar, SPECIAL_INDEX);
   for(;;) {
     TermSpec binding;
-    bool found=_bank.find(v,binding);
+    bool found=findBinding(v,binding);
     if(!found || binding.index==UNBOUND_INDEX) {
       static TermList auxVarTerm(1,false);
       return auxVarTerm;
@@ -173,7 +302,7 @@ RobSubstitution::TermSpec RobSubstitution::derefBound(TermSpec t) const
   VarSpec v=getVarSpec(t);
   for(;;) {
     TermSpec binding;
-    bool found=_bank.find(v,binding);
+    bool found=findBinding(v,binding);
     if(!found || binding.index==UNBOUND_INDEX) {
       return TermSpec(v);
     } else if(binding.term.isTerm()) {
@@ -194,7 +323,7 @@ RobSubstitution::TermSpec RobSubstitution::deref(VarSpec v) const
   CALL("RobSubstitution::deref");
   for(;;) {
     TermSpec binding;
-    bool found=_bank.find(v,binding);
+    bool found=findBinding(v,binding);
     if(!found) {
       binding.index=UNBOUND_INDEX;
       binding.term.makeVar(_nextUnboundAvailable++);
@@ -216,10 +345,18 @@ void RobSubstitution::bind(const VarSpec& v, const TermSpec& b)
   //ASS(!b.term.isTerm() || b.index!=AUX_INDEX || b.term.term()->shared());
   ASS_NEQ(v.index, UNBOUND_INDEX);
 
-  if(bdIsRecording()) {
-    bdAdd(new BindingBacktrackObject(this, v));
+  bool recording=bdIsRecording();
+  if(_undoScopeDepth || recording) {
+    TermSpec previous;
+    if(!findBinding(v,previous)) {
+      previous.term.makeEmpty();
+    }
+    _trail.push(TrailEntry(v,previous));
+    if(!_undoScopeDepth) {
+      bdAdd(new TrailBacktrackObject(this, _trail.size()-1));
+    }
   }
-  _bank.set(v,b);
+  setBinding(v,b);
 }
 
 void RobSubstitution::bindVar(const VarSpec& var, const VarSpec& to)
@@ -235,7 +372,7 @@ RobSubstitution::VarSpec RobSubstitution::root(VarSpec v) const
   CALL("RobSubstitution::root");
   for(;;) {
     TermSpec binding;
-    bool found=_bank.find(v,binding);
+    bool found=findBinding(v,binding);
     if(!found || binding.index==UNBOUND_INDEX || binding.term.isTerm()) {
       return v;
     }
@@ -341,8 +478,8 @@ bool RobSubstitution::unify(TermSpec t1, TermSpec t2,MismatchHandler* hndlr)
   }
 
   bool mismatch=false;
-  BacktrackData localBD;
-  bdRecord(localBD);
+  unsigned mark=_trail.size();
+  openUndoScope();
 
   static Stack<TTPair> toDo(64);
   static Stack<TermList*> subterms(64);
@@ -459,16 +596,7 @@ bool RobSubstitution::unify(TermSpec t1, TermSpec t2,MismatchHandler* hndlr)
     toDo.reset();
   }
 
-  bdDone();
-
-  if(mismatch) {
-    localBD.backtrack();
-  } else {
-    if(bdIsRecording()) {
-      bdCommit(localBD);
-    }
-    localBD.drop();
-  }
+  closeUndoScope(mark, !mismatch);
 
   return !mismatch;
 }
@@ -491,8 +619,8 @@ bool RobSubstitution::match(TermSpec base, TermSpec instance)
   }
 
   bool mismatch=false;
-  BacktrackData localBD;
-  bdRecord(localBD);
+  unsigned mark=_trail.size();
+  openUndoScope();
 
   static Stack<TermList*> subterms(64);
   ASS(subterms.isEmpty());
@@ -518,7 +646,7 @@ bool RobSubstitution::match(TermSpec base, TermSpec instance)
       if (! TermList::sameTopFunctor(bts.term,its.term)) {
 	if(bts.term.isSpecialVar()) {
 	  VarSpec bvs(bts.term.var(), SPECIAL_INDEX);
-	  if(_bank.find(bvs, binding1)) {
+	  if(findBinding(bvs, binding1)) {
 	    ASS_EQ(binding1.index, base.index);
 	    bt=&binding1.term;
 	    continue;
@@ -527,7 +655,7 @@ bool RobSubstitution::match(TermSpec base, TermSpec instance)
 	  }
 	} else if(its.term.isSpecialVar()) {
 	  VarSpec ivs(its.term.var(), SPECIAL_INDEX);
-	  if(_bank.find(ivs, binding2)) {
+	  if(findBinding(ivs, binding2)) {
 	    ASS_EQ(binding2.index, instance.index);
 	    it=&binding2.term;
 	    continue;
@@ -536,7 +664,7 @@ bool RobSubstitution::match(TermSpec base, TermSpec instance)
 	  }
 	} else if(bts.term.isOrdinaryVar()) {
 	  VarSpec bvs(bts.term.var(), bts.index);
-	  if(_bank.find(bvs, binding1)) {
+	  if(findBinding(bvs, binding1)) {
 	    ASS_EQ(binding1.index, instance.index);
 	    if(!TermList::equals(binding1.term, its.term))
 	    {
@@ -564,19 +692,9 @@ bool RobSubstitution::match(TermSpec base, TermSpec instance)
     }
   }
 
-  bdDone();
-
   subterms.reset();
 
-
-  if(mismatch) {
-    localBD.backtrack();
-  } else {
-    if(bdIsRecording()) {
-      bdCommit(localBD);
-    }
-    localBD.drop();
-  }
+  closeUndoScope(mark, !mismatch);
 
   return !mismatch;
 }
@@ -1034,26 +1152,50 @@ vstring RobSubstitution::toString(bool deref) const
 {
   CALL("RobSubstitution::toString");
   vstring res;
-  BankType::Iterator bit(_bank);
-  while(bit.hasNext()) {
-    VarSpec v;
-    TermSpec binding;
-    bit.next(v,binding);
-    TermList tl;
-    if(v.index==SPECIAL_INDEX) {
-      res+="S"+Int::toString(v.var)+" -> ";
-      tl.makeSpecialVar(v.var);
-    } else {
-      res+="X"+Int::toString(v.var)+"/"+Int::toString(v.index)+ " -> ";
-      tl.makeVar(v.var);
+  for(unsigned i=0;i<_banks.size();i++) {
+    if(!_banks[i]) {
+      continue;
     }
-    if(deref) {
-      tl=apply(tl, v.index);
-      res+=tl.toString()+"\n";
-    } else {
-      res+=binding.term.toString()+"/"+Int::toString(binding.index)+"\n";
+    for(unsigned var=0;var<_banks[i]->size();var++) {
+      VarSpec v(var, static_cast<int>(i)+SPECIAL_INDEX);
+      TermSpec binding;
+      if(!findBinding(v,binding)) {
+        continue;
+      }
+      TermList tl;
+      if(v.index==SPECIAL_INDEX) {
+        res+="S"+Int::toString(v.var)+" -> ";
+        tl.makeSpecialVar(v.var);
+      } else {
+        res+="X"+Int::toString(v.var)+"/"+Int::toString(v.index)+ " -> ";
+        tl.makeVar(v.var);
+      }
+      if(deref) {
+        tl=apply(tl, v.index);
+        res+=tl.toString()+"\n";
+      } else {
+        res+=binding.term.toString()+"/"+Int::toString(binding.index)+"\n";
+      }
     }
+  }
+  return res;
+}
+
+size_t RobSubstitution::size() const
+{
+  CALL("RobSubstitution::size");
 
+  size_t res=0;
+  for(unsigned i=0;i<_banks.size();i++) {
+    if(!_banks[i]) {
+      continue;
+    }
+    for(unsigned var=0;var<_banks[i]->size();var++) {
+      TermSpec binding;
+      if(findBinding(VarSpec(var, static_cast<int>(i)+SPECIAL_INDEX),binding)) {
+        res++;
+      }
+    }
   }
   return res;
 }
@@ -19,8 +19,10 @@
 #include <utility>
 
 #include "Forwards.hpp"
+#include "Lib/DArray.hpp"
 #include "Lib/DHMap.hpp"
 #include "Lib/Backtrackable.hpp"
+#include "Lib/Stack.hpp"
 #include "Term.hpp"
 #include "MismatchHandler.hpp"
 
@@ -28,6 +30,7 @@
 
 #include <iostream>
 #include "Lib/VString.hpp"
+#include "Lib/Int.hpp"
 
 #endif
 
@@ -37,6 +40,28 @@ namespace Kernel
 using namespace std;
 using namespace Lib;
 
+/**
+ * Substitution used for unification and matching of terms from
+ * several variable banks.
+ *
+ * Bindings are kept in dense arrays indexed by the variable bank and
+ * the variable number. A binding is valid only if it carries the current
+ * stamp, so that the substitution can be reset in constant time.
+ * Changes are undone using a trail of previous bindings; a successful
+ * unification or matching adds a single backtrack object covering all
+ * the bindings it made to the BacktrackData being recorded.
+ *
+ * A backtrack object undoes everything on the trail above the point where
+ * it was created. Backtracking BacktrackData out of the LIFO order of
+ * recording therefore also undoes the bindings recorded later, including
+ * those recorded into other BacktrackData objects.
+ *
+ * The trail is emptied only by reset() and by backtracking. The entries
+ * of a BacktrackData that is committed or dropped while nothing else is
+ * being recorded (as in HyperSuperposition::tryToUnifyTwoTermPairs) stay
+ * on the trail until the next reset(), so the trail grows by the number
+ * of such bindings between two resets.
+ */
 class RobSubstitution
 :public Backtrackable
 {
@@ -44,7 +69,8 @@ public:
   CLASS_NAME(RobSubstitution);
   USE_ALLOCATOR(RobSubstitution);
   
-  RobSubstitution() : _nextUnboundAvailable(0) {} //,_nextAuxAvailable(0) {}
+  RobSubstitution() : _stamp(1), _undoScopeDepth(0), _nextUnboundAvailable(0) {} //,_nextAuxAvailable(0) {}
+  ~RobSubstitution();
 
   SubstIterator matches(Literal* base, int baseIndex,
 	  Literal* instance, int instanceIndex, bool complementary);
@@ -65,12 +91,7 @@ public:
   {
     return isUnbound(VarSpec(var,SPECIAL_INDEX));
   }
-  void reset()
-  {
-    _bank.reset();
-    //_nextAuxAvailable=0;
-    _nextUnboundAvailable=0;
-  }
+  void reset();
   /**
    * Bind special variable to a specified term
    *
@@ -81,7 +102,8 @@ public:
   void bindSpecialVar(unsigned var, TermList t, int index)
   {
     VarSpec vs(var, SPECIAL_INDEX);
-    ASS(!_bank.find(vs));
+    DEBUG_CODE(TermSpec aux;)
+    ASS(!findBinding(vs,aux));
     bind(vs, TermSpec(t,index));
   }
   TermList getSpecialVarTop(unsigned specialVar) const;
@@ -98,7 +120,9 @@ public:
    * - 0 means a fresh substitution.
    * - Without backtracking, this number doesn't decrease.
    */
-  size_t size() const {return _bank.size(); }
+  size_t size() const;
+  /** Set the stamp, so that the wrap-around in reset() can be tested */
+  void setStamp(unsigned stamp) { _stamp=stamp; }
 #endif
 
 
@@ -259,9 +283,45 @@ private:
   }
   static void swap(TermSpec& ts1, TermSpec& ts2);
 
-  typedef DHMap<VarSpec,TermSpec,VarSpec::Hash1, VarSpec::Hash2> BankType;
+  /** Binding of a variable, valid only if @b stamp is the current stamp */
+  struct BankEntry
+  {
+    BankEntry() : stamp(0) {}
+
+    TermSpec binding;
+    unsigned stamp;
+  };
+  typedef DArray<BankEntry> Bank;
+
+  /** Record of a binding change, @b previous is empty if the variable was unbound */
+  struct TrailEntry
+  {
+    TrailEntry() {}
+    TrailEntry(const VarSpec& var, const TermSpec& previous) : var(var), previous(previous) {}
+
+    VarSpec var;
+    TermSpec previous;
+  };
+
+  bool findBinding(const VarSpec& v, TermSpec& binding) const;
+  void setBinding(const VarSpec& v, const TermSpec& binding);
+  void undoTrail(unsigned mark);
 
-  mutable BankType _bank;
+  void openUndoScope() { _undoScopeDepth++; }
+  void closeUndoScope(unsigned mark, bool success);
+
+  /** Banks of bindings, the bank of index i is at position i-SPECIAL_INDEX */
+  Stack<Bank*> _banks;
+  /** Bindings are valid only if their stamp is equal to this one */
+  unsigned _stamp;
+
+  /** Previous values of the bindings that may still need to be undone */
+  Stack<TrailEntry> _trail;
+  /**
+   * Number of unifications and matchings in progress; while positive,
+   * all bindings go to the trail so that they can be undone on failure
+   */
+  unsigned _undoScopeDepth;
 
   // Unused
   //DHMap<int, int> _denormIndexes;
@@ -269,37 +329,28 @@ private:
   mutable unsigned _nextUnboundAvailable;
   //unsigned _nextAuxAvailable;
 
-  class BindingBacktrackObject
+  /** Undoes the bindings on the trail above a given mark */
+  class TrailBacktrackObject
   : public BacktrackObject
   {
   public:
-    BindingBacktrackObject(RobSubstitution* subst, VarSpec v)
-    :_subst(subst), _var(v)
-    {
-      if(! _subst->_bank.find(_var,_term)) {
-	_term.term.makeEmpty();
-      }
-    }
+    TrailBacktrackObject(RobSubstitution* subst, unsigned mark)
+    :_subst(subst), _mark(mark) {}
     void backtrack()
     {
-      if(_term.term.isEmpty()) {
-	_subst->_bank.remove(_var);
-      } else {
-	_subst->_bank.set(_var,_term);
-      }
+      _subst->undoTrail(_mark);
     }
 #if VDEBUG
     vstring toString() const
     {
-      return "(ROB backtrack object for "+ _var.toString() +")";
+      return "(ROB backtrack object for trail above "+ Int::toString(_mark) +")";
     }
 #endif
-    CLASS_NAME(RobSubstitution::BindingBacktrackObject);
-    USE_ALLOCATOR(BindingBacktrackObject);
+    CLASS_NAME(RobSubstitution::TrailBacktrackObject);
+    USE_ALLOCATOR(TrailBacktrackObject);
   private:
     RobSubstitution* _subst;
-    VarSpec _var;
-    TermSpec _term;
+    unsigned _mark;
   };
 
   template<class Fn>
@@ -268,6 +268,18 @@ bool Term::containsSubterm(TermList trm)
     return false;
   }
 
+  // subterms whose summary shows they cannot contain trm are not entered
+  const Indexing::TermSharing& sharing=*env.sharing;
+  bool trmIsVar=trm.isVar();
+  unsigned long long trmVarBit=trmIsVar ? Indexing::TermSharing::varMaskBit(trm.var()) : 0;
+  unsigned trmDepth=trmIsVar ? 1 : sharing.summary(trm.term()).depth;
+  if (!isLiteral()) {
+    const Indexing::TermSharing::TermSummary& sum=sharing.summary(this);
+    if (trmIsVar ? !(sum.varMask&trmVarBit) : sum.depth<=trmDepth) {
+      return false;
+    }
+  }
+
   TermList* ts=args();
   static Stack<TermList*> stack(4);
   stack.reset();
@@ -280,7 +292,9 @@ bool Term::containsSubterm(TermList trm)
     }
     if (ts->isTerm()) {
       ASSERT_VALID(*ts->term());
-      if (ts->term()->arity()) {
+      const Indexing::TermSharing::TermSummary& sum=sharing.summary(ts->term());
+      if (trmIsVar ? (sum.varMask&trmVarBit) : sum.depth>trmDepth) {
+	ASS(ts->term()->arity());
 	stack.push(ts->term()->args());
       }
     }
@@ -718,6 +732,29 @@ Literal* Literal::apply(Substitution& subst)
 } // Literal::apply
 
 
+/**
+ * Continue the FNV hash @b hash with the @b arity arguments stored
+ * from @b args on.
+ *
+ * The arguments are hashed one machine word at a time rather than
+ * byte by byte, which makes hashing of the top-level of a term,
+ * done on every insertion into the term sharing structure, several
+ * times cheaper. As the low bits of the words hardly differ (term
+ * pointers are aligned), the result is mixed once more at the end.
+ */
+static unsigned hashArguments(const TermList* args, unsigned arity, unsigned hash)
+{
+  for (unsigned i = 0; i < arity; i++) {
+    unsigned long long content = args[i].content();
+    hash = (hash ^ static_cast<unsigned>(content)) * 16777619u;
+    hash = (hash ^ static_cast<unsigned>(content >> 32)) * 16777619u;
+  }
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6bu;
+  hash ^= hash >> 13;
+  return hash;
+} // hashArguments
+
 /**
  * Return the hash function of the top-level of a complex term.
  * @pre The term must be non-variable
@@ -731,8 +768,7 @@ unsigned Term::hash() const
   if (_arity == 0) {
     return hash;
   }
-  return Hash::hash(reinterpret_cast<const unsigned char*>(_args+1),
- 		       _arity*sizeof(TermList),hash);
+  return hashArguments(_args+1,_arity,hash);
 } // Term::hash
 
 /**
@@ -743,31 +779,34 @@ unsigned Literal::hash() const
 {
   CALL("Literal::hash");
 
-  unsigned hash = Hash::hash(isPositive() ? (2*_functor) : (2*_functor+1));
-  if (_arity == 0) {
-    return hash;
-  }
-  if (isTwoVarEquality()) {
-    hash ^= Hash::hash(twoVarEqSort());
-  }
-  return Hash::hash(reinterpret_cast<const unsigned char*>(_args+1),
- 		       _arity*sizeof(TermList),hash);
-} // Term::hash
+  return hash(isPositive());
+} // Literal::hash
 
 /**
  * Return the hash function of the top-level of a literal with opposite polarity.
  */
 unsigned Literal::oppositeHash() const
 {
-  CALL("Literal::hash");
+  CALL("Literal::oppositeHash");
+
+  return hash(!isPositive());
+} // Literal::oppositeHash
 
-  unsigned hash = Hash::hash( (!isPositive()) ? (2*_functor) : (2*_functor+1));
+/**
+ * Return the hash function of the top-level of the literal if its
+ * polarity was @b positive.
+ */
+unsigned Literal::hash(bool positive) const
+{
+  unsigned hash = Hash::hash(positive ? (2*_functor) : (2*_functor+1));
   if (_arity == 0) {
     return hash;
   }
-  return Hash::hash(reinterpret_cast<const unsigned char*>(_args+1),
- 		       _arity*sizeof(TermList),hash);
-} // Term::hash
+  if (isTwoVarEquality()) {
+    hash ^= Hash::hash(twoVarEqSort());
+  }
+  return hashArguments(_args+1,_arity,hash);
+} // Literal::hash
 
 /**
  * Return literal opposite to @b l.
@@ -775,6 +775,7 @@ public:
 
   unsigned hash() const;
   unsigned oppositeHash() const;
+  unsigned hash(bool positive) const;
   static Literal* complementaryLiteral(Literal* l);
   /** If l is positive, return l; otherwise return its complementary literal. */
   static Literal* positiveLiteral(Literal* l) {
@@ -81,6 +81,82 @@ void DIMACS::outputGroundedProblem(MapToLIFO<Clause*, SATClause*>& insts,
   out<<"%"<<endl<<"0"<<endl;
 }
 
+void DIMACS::outputHeader(unsigned varCnt, unsigned clauseCnt, ostream& out)
+{
+  out<<"p cnf "<<varCnt<<" "<<clauseCnt<<endl;
+}
+
+/**
+ * Read the output of a SAT solver in the format of the SAT competition,
+ * i.e. a status line "s SATISFIABLE", "s UNSATISFIABLE" or "s UNKNOWN" and
+ * the model in lines "v <literals>" terminated by 0. Variables up to
+ * @b varCnt that the model does not mention are assigned DONT_CARE.
+ *
+ * Malformed output (an unknown or repeated status line, a model with
+ * a token that is not a literal up to @b varCnt, or a model that is not
+ * terminated) gives UNKNOWN.
+ */
+SATSolver::Status DIMACS::readSolverOutput(istream& in, unsigned varCnt,
+    DArray<SATSolver::VarAssignment>& assignment)
+{
+  CALL("DIMACS::readSolverOutput");
+
+  assignment.init(varCnt+1,SATSolver::DONT_CARE);
+  SATSolver::Status res = SATSolver::UNKNOWN;
+  bool haveStatus = false;
+  bool modelTerminated = false;
+
+  vstring line;
+  while(getline(in,line)) {
+    if(line.empty()) {
+      continue;
+    }
+    if(line[0]=='s') {
+      vistringstream words(line.substr(1));
+      vstring status, rest;
+      words >> status;
+      if(haveStatus || (words >> rest)) {
+        return SATSolver::UNKNOWN;
+      }
+      haveStatus = true;
+      if(status=="SATISFIABLE") {
+        res = SATSolver::SATISFIABLE;
+      }
+      else if(status=="UNSATISFIABLE") {
+        res = SATSolver::UNSATISFIABLE;
+      }
+      else if(status!="UNKNOWN") {
+        return SATSolver::UNKNOWN;
+      }
+      continue;
+    }
+    if(line[0]!='v') {
+      continue;
+    }
+    vistringstream lits(line.substr(1));
+    vstring token;
+    while(lits>>token) {
+      int lit;
+      if(modelTerminated || !Int::stringToInt(token,lit)) {
+        return SATSolver::UNKNOWN;
+      }
+      if(lit==0) {
+        modelTerminated = true;
+        continue;
+      }
+      unsigned var = lit>0 ? lit : -lit;
+      if(var>varCnt) {
+        return SATSolver::UNKNOWN;
+      }
+      assignment[var] = lit>0 ? SATSolver::TRUE : SATSolver::FALSE;
+    }
+  }
+  if(res==SATSolver::SATISFIABLE && !modelTerminated) {
+    return SATSolver::UNKNOWN;
+  }
+  return res;
+}
+
 void DIMACS::getStats(SATClauseIterator clauses, unsigned& clauseCnt, unsigned& maxVar)
 {
   clauseCnt=0;
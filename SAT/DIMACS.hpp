@@ -16,9 +16,11 @@
 #define __DIMACS__
 
 #include "Forwards.hpp"
+#include "Lib/DArray.hpp"
 #include "Lib/VirtualIterator.hpp"
 
 #include "SATClause.hpp"
+#include "SATSolver.hpp"
 
 namespace SAT
 {
@@ -29,6 +31,10 @@ public:
   static void outputGroundedProblem(MapToLIFO<Clause*, SATClause*>& insts,
 	  SATClause::NamingContext& nctx, ostream& out);
 
+  static void outputHeader(unsigned varCnt, unsigned clauseCnt, ostream& out);
+  static SATSolver::Status readSolverOutput(istream& in, unsigned varCnt,
+      DArray<SATSolver::VarAssignment>& assignment);
+
 private:
   static void getStats(SATClauseIterator clauses, unsigned& clauseCnt, unsigned& maxVar);
 };
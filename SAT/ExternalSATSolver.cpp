@@ -0,0 +1,384 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file ExternalSATSolver.cpp
+ * Implements class ExternalSATSolver
+ */
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <iomanip>
+#include <signal.h>
+#include <unistd.h>
+
+#include "Lib/Allocator.hpp"
+#include "Lib/DArray.hpp"
+#include "Lib/Exception.hpp"
+#include "Lib/System.hpp"
+#include "Lib/Sys/Multiprocessing.hpp"
+
+#include "DIMACS.hpp"
+
+#include "ExternalSATSolver.hpp"
+
+namespace SAT
+{
+
+using namespace Lib;
+using namespace Lib::Sys;
+
+pid_t ExternalSATSolver::s_runningCommand = 0;
+Stack<ExternalSATSolver*> ExternalSATSolver::s_instances;
+
+/**
+ * Width of the header of the problem file. It is followed by a comment
+ * line padded so that the header can be rewritten in place with any
+ * numbers of variables and clauses.
+ */
+static const unsigned HEADER_WIDTH = 40;
+
+ExternalSATSolver::ExternalSATSolver(vstring command, vstring problemFile)
+: _problemFile(problemFile), _removeProblemFile(problemFile.empty()),
+  _writtenAssumptionCnt(0), _clauseCnt(0), _varCnt(0), _status(UNKNOWN)
+{
+  CALL("ExternalSATSolver::ExternalSATSolver");
+
+  splitCommand(command,_commandArgs);
+  if(_commandArgs.isEmpty()) {
+    USER_ERROR("The SAT solver command is empty");
+  }
+
+  static bool handlerAdded = false;
+  if(!handlerAdded) {
+    System::addTerminationHandler(onTermination);
+    handlerAdded = true;
+  }
+
+  // a directory only we can access, so that nobody can create or replace
+  // our files in it, and each solver has its own
+  const char* tmpRoot = getenv("TMPDIR");
+  vstring pattern = vstring(tmpRoot && *tmpRoot ? tmpRoot : "/tmp")+"/vampire_sat_XXXXXX";
+  DArray<char> buf(pattern.size()+1);
+  pattern.copy(buf.array(), pattern.size());
+  buf[pattern.size()] = 0;
+  errno = 0;
+  if(!mkdtemp(buf.array())) {
+    SYSTEM_FAIL("Cannot create a temporary directory "+pattern, errno);
+  }
+  _tmpDir = buf.array();
+  s_instances.push(this);
+  if(_removeProblemFile) {
+    _problemFile = _tmpDir+"/problem.cnf";
+  }
+  _outputFile = _tmpDir+"/solver.out";
+
+  BYPASSING_ALLOCATOR;
+
+  _problemOut = new std::fstream(_problemFile.c_str(),
+      std::ios::in | std::ios::out | std::ios::trunc);
+  if(!_problemOut->good()) {
+    USER_ERROR("Cannot write the file "+_problemFile);
+  }
+  writeHeader();
+  _clausesEnd = HEADER_WIDTH;
+}
+
+ExternalSATSolver::~ExternalSATSolver()
+{
+  CALL("ExternalSATSolver::~ExternalSATSolver");
+
+  // a kept problem file must have the right header
+  writeHeader();
+  {
+    BYPASSING_ALLOCATOR;
+
+    delete _problemOut;
+  }
+  removeFiles();
+  ALWAYS(s_instances.remove(this));
+}
+
+/**
+ * Remove the temporary files and directory.
+ */
+void ExternalSATSolver::removeFiles()
+{
+  remove(_outputFile.c_str());
+  if(_removeProblemFile) {
+    remove(_problemFile.c_str());
+  }
+  rmdir(_tmpDir.c_str());
+}
+
+/**
+ * Split @b command into @b args at spaces. Spaces within single or double
+ * quotes or preceded by a backslash are kept, so that the command can
+ * name a program whose path contains spaces.
+ */
+void ExternalSATSolver::splitCommand(const vstring& command, Stack<vstring>& args)
+{
+  CALL("ExternalSATSolver::splitCommand");
+
+  vstring arg;
+  bool inArg = false;
+  char quote = 0;
+  for(size_t i=0;i<command.size();i++) {
+    char c = command[i];
+    if(quote) {
+      if(c==quote) {
+        quote = 0;
+      }
+      else {
+        arg += c;
+      }
+    }
+    else if(c=='\'' || c=='"') {
+      quote = c;
+      inArg = true;
+    }
+    else if(c=='\\' && i+1<command.size()) {
+      arg += command[++i];
+      inArg = true;
+    }
+    else if(c==' ' || c=='\t') {
+      if(inArg) {
+        args.push(arg);
+        arg = "";
+        inArg = false;
+      }
+    }
+    else {
+      arg += c;
+      inArg = true;
+    }
+  }
+  if(quote) {
+    USER_ERROR("Unterminated quote in the SAT solver command "+command);
+  }
+  if(inArg) {
+    args.push(arg);
+  }
+}
+
+/**
+ * Write the header with the current numbers of variables and clauses
+ * to the start of the problem file, padded to HEADER_WIDTH.
+ */
+void ExternalSATSolver::writeHeader()
+{
+  CALL("ExternalSATSolver::writeHeader");
+
+  BYPASSING_ALLOCATOR;
+
+  vostringstream header;
+  DIMACS::outputHeader(_varCnt,_clauseCnt+_writtenAssumptionCnt,header);
+  vstring line = header.str();
+  ASS_L(line.size()+2,HEADER_WIDTH);
+
+  _problemOut->seekp(0);
+  *_problemOut << line << 'c' << std::setw(HEADER_WIDTH-line.size()-1) << '\n';
+}
+
+/**
+ * Cut the assumptions of the last call to solve off the problem file.
+ */
+void ExternalSATSolver::discardAssumptions()
+{
+  CALL("ExternalSATSolver::discardAssumptions");
+
+  if(!_writtenAssumptionCnt) {
+    return;
+  }
+  BYPASSING_ALLOCATOR;
+
+  _problemOut->flush();
+  errno = 0;
+  if(truncate(_problemFile.c_str(),_clausesEnd)) {
+    SYSTEM_FAIL("Cannot truncate the file "+_problemFile, errno);
+  }
+  _problemOut->seekp(_clausesEnd);
+  _writtenAssumptionCnt = 0;
+}
+
+/**
+ * Append the clause to the problem file. The clause is not needed afterwards.
+ */
+void ExternalSATSolver::addClause(SATClause* cl)
+{
+  CALL("ExternalSATSolver::addClause");
+
+  ASS(!hasAssumptions());
+
+  discardAssumptions();
+
+  unsigned clen=cl->length();
+  for(unsigned i=0;i<clen;i++) {
+    ensureVarCount((*cl)[i].var());
+  }
+  vstring line = cl->toDIMACSString();
+  {
+    BYPASSING_ALLOCATOR;
+
+    *_problemOut << line << '\n';
+    // tellp() would flush the stream, so the offset is only checked by it
+    _clausesEnd += line.size()+1;
+    ASS_EQ(_clausesEnd,_problemOut->tellp());
+  }
+  _clauseCnt++;
+}
+
+/**
+ * Complete the problem file by its header and the current assumptions,
+ * run the command on it and read back the result. The conflict count
+ * limit is not passed to the command.
+ */
+SATSolver::Status ExternalSATSolver::solve(unsigned conflictCountLimit)
+{
+  CALL("ExternalSATSolver::solve");
+
+  discardAssumptions();
+  {
+    BYPASSING_ALLOCATOR;
+
+    _problemOut->seekp(_clausesEnd);
+    for(unsigned i=0;i<_assumptions.size();i++) {
+      SATLiteral lit = _assumptions[i];
+      *_problemOut << (lit.polarity() ? "" : "-") << lit.var() << " 0\n";
+    }
+    _writtenAssumptionCnt = _assumptions.size();
+    writeHeader();
+    _problemOut->flush();
+    if(!_problemOut->good()) {
+      USER_ERROR("Cannot write the file "+_problemFile);
+    }
+  }
+
+  int exitStatus = runCommand();
+
+  {
+    BYPASSING_ALLOCATOR;
+
+    std::ifstream output(_outputFile.c_str());
+    _status = DIMACS::readSolverOutput(output,_varCnt,_assignment);
+  }
+  remove(_outputFile.c_str());
+
+  // solvers following the conventions of the SAT competition exit with 20
+  // on unsatisfiable problems, even when they do not print the status line
+  if(_status==UNKNOWN && exitStatus==20) {
+    _status = UNSATISFIABLE;
+  }
+  return _status;
+}
+
+/**
+ * Run the command on the problem file with its output going to the output
+ * file, wait for it to finish and return its exit status (or the signal
+ * number increased by 256 if it was killed).
+ */
+int ExternalSATSolver::runCommand()
+{
+  CALL("ExternalSATSolver::runCommand");
+
+  // prepare everything before forking, the child only calls exec
+  DArray<const char*> argv(_commandArgs.size()+2);
+  for(unsigned i=0;i<_commandArgs.size();i++) {
+    argv[i] = _commandArgs[i].c_str();
+  }
+  argv[_commandArgs.size()] = _problemFile.c_str();
+  argv[_commandArgs.size()+1] = 0;
+
+  errno = 0;
+  int outFd = open(_outputFile.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0600);
+  if(outFd==-1) {
+    SYSTEM_FAIL("Cannot create the file "+_outputFile, errno);
+  }
+
+  // not Multiprocessing::fork, whose handlers would restart the timer
+  // of Vampire in the child, and its signals would kill the command
+  errno = 0;
+  pid_t child = fork();
+  if(child==-1) {
+    SYSTEM_FAIL("Call to fork() function failed.", errno);
+  }
+  if(!child) {
+    if(dup2(outFd,STDOUT_FILENO)==-1) {
+      _exit(127);
+    }
+    close(outFd);
+    execvp(argv[0], const_cast<char* const*>(argv.array()));
+    _exit(127);
+  }
+  close(outFd);
+
+  s_runningCommand = child;
+  int exitStatus;
+  Multiprocessing::instance()->waitForParticularChildTermination(child, exitStatus);
+  s_runningCommand = 0;
+
+  if(exitStatus==127) {
+    USER_ERROR("Cannot run the SAT solver "+_commandArgs[0]);
+  }
+  return exitStatus;
+}
+
+/**
+ * Termination handler killing the command if it is running, so that it
+ * does not outlive Vampire hitting its time limit or being killed, and
+ * removing the temporary files of the solvers. This is also the only
+ * cleanup of solvers that are never destroyed, such as those of the
+ * proof state a portfolio slice keeps (see ProvingHelper::runVampire).
+ */
+void ExternalSATSolver::onTermination()
+{
+  if(s_runningCommand) {
+    kill(s_runningCommand, SIGKILL);
+    s_runningCommand = 0;
+  }
+  Stack<ExternalSATSolver*>::Iterator it(s_instances);
+  while(it.hasNext()) {
+    it.next()->removeFiles();
+  }
+}
+
+SATSolver::Status ExternalSATSolver::solveUnderAssumptions(const SATLiteralStack& assumps, unsigned conflictCountLimit, bool)
+{
+  CALL("ExternalSATSolver::solveUnderAssumptions");
+
+  ASS(!hasAssumptions());
+
+  _assumptions.loadFromIterator(SATLiteralStack::ConstIterator(assumps));
+  Status res = solve(conflictCountLimit);
+
+  _failedAssumptionBuffer.reset();
+  if(res==UNSATISFIABLE) {
+    // we cannot do better than all of them
+    _failedAssumptionBuffer.loadFromIterator(SATLiteralStack::ConstIterator(assumps));
+  }
+  // keep the status, the model is still valid
+  _assumptions.reset();
+  return res;
+}
+
+SATSolver::VarAssignment ExternalSATSolver::getAssignment(unsigned var)
+{
+  CALL("ExternalSATSolver::getAssignment");
+  ASS_EQ(_status, SATISFIABLE);
+  ASS_G(var,0);
+
+  if(var<_assignment.size()) {
+    return _assignment[var];
+  }
+  return DONT_CARE;
+}
+
+}
@@ -0,0 +1,134 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file ExternalSATSolver.hpp
+ * Defines class ExternalSATSolver
+ */
+#ifndef __ExternalSATSolver__
+#define __ExternalSATSolver__
+
+#include <fstream>
+#include <sys/types.h>
+
+#include "Lib/DArray.hpp"
+#include "Lib/Stack.hpp"
+
+#include "SATSolver.hpp"
+#include "SATLiteral.hpp"
+#include "SATClause.hpp"
+
+namespace SAT{
+
+/**
+ * A SAT solver running an external program on a DIMACS file.
+ *
+ * Clauses are appended to the problem file as they are added, so the
+ * solver does not keep them in memory. The header at the start of the
+ * file has a fixed width and is rewritten in place, and the assumptions
+ * (as unit clauses) are appended before each call to solve and cut off
+ * again when the next clause is added. So each call writes only the
+ * header and the assumptions, not the clauses added before.
+ *
+ * The command is run directly (not by a shell) with the name of the
+ * problem file as its last argument (see splitCommand for how its
+ * arguments are separated), and is expected to answer in the
+ * format of the SAT competition (see DIMACS::readSolverOutput). It is
+ * killed if Vampire terminates while it runs.
+ *
+ * The external program cannot tell which assumptions were needed
+ * for unsatisfiability, so all of them are reported as failed.
+ */
+class ExternalSATSolver : public SATSolverWithAssumptions
+{
+public:
+  CLASS_NAME(ExternalSATSolver);
+  USE_ALLOCATOR(ExternalSATSolver);
+
+  /**
+   * Run @b command, whose arguments are separated by spaces, with the name
+   * of the problem file as its last argument. The problem is written
+   * to @b problemFile, or to a file in a private temporary directory
+   * (removed with the solver) if it is empty.
+   */
+  ExternalSATSolver(vstring command, vstring problemFile);
+  ~ExternalSATSolver();
+
+  virtual void addClause(SATClause* cl) override;
+
+  virtual Status solve(unsigned conflictCountLimit) override;
+
+  virtual VarAssignment getAssignment(unsigned var) override;
+
+  virtual bool isZeroImplied(unsigned var) override { return false; }
+  virtual void collectZeroImplied(SATLiteralStack& acc) override {}
+  virtual SATClause* getZeroImpliedCertificate(unsigned var) override { return 0; }
+
+  virtual void ensureVarCount(unsigned newVarCnt) override {
+    if(newVarCnt > _varCnt) {
+      _varCnt = newVarCnt;
+    }
+  }
+
+  virtual unsigned newVar() override { return ++_varCnt; }
+
+  virtual void suggestPolarity(unsigned var, unsigned pol) override {}
+
+  virtual void addAssumption(SATLiteral lit) override { _assumptions.push(lit); }
+
+  virtual void retractAllAssumptions() override {
+    _assumptions.reset();
+    _status = UNKNOWN;
+  }
+
+  virtual bool hasAssumptions() const override { return _assumptions.isNonEmpty(); }
+
+  Status solveUnderAssumptions(const SATLiteralStack& assumps, unsigned conflictCountLimit, bool) override;
+
+  virtual SATClause* getRefutation() override { ASSERTION_VIOLATION; }
+
+private:
+  void discardAssumptions();
+  void writeHeader();
+  int runCommand();
+  void removeFiles();
+
+  static void splitCommand(const vstring& command, Stack<vstring>& args);
+  static void onTermination();
+
+  /** the program and the arguments of the command */
+  Stack<vstring> _commandArgs;
+  /** private temporary directory, empty if not used */
+  vstring _tmpDir;
+  vstring _problemFile;
+  // file receiving the output of the command
+  vstring _outputFile;
+  bool _removeProblemFile;
+
+  std::fstream* _problemOut;
+  /** offset of the end of the clauses in the problem file */
+  std::streamoff _clausesEnd;
+  /** number of assumptions following the clauses in the problem file */
+  unsigned _writtenAssumptionCnt;
+  unsigned _clauseCnt;
+  unsigned _varCnt;
+
+  /** pid of the command that is running, 0 if none */
+  static pid_t s_runningCommand;
+  /** existing solvers, whose files are removed on termination */
+  static Stack<ExternalSATSolver*> s_instances;
+
+  Status _status;
+  SATLiteralStack _assumptions;
+  DArray<VarAssignment> _assignment;
+};
+
+}//end SAT namespace
+
+#endif /*__ExternalSATSolver__*/
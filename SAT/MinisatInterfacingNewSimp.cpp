@@ -35,10 +35,13 @@ using namespace Minisat;
 
 const unsigned MinisatInterfacingNewSimp::VAR_MAX = std::numeric_limits<Minisat::Var>::max() / 2;
   
-MinisatInterfacingNewSimp::MinisatInterfacingNewSimp(const Shell::Options& opts, bool generateProofs):
+MinisatInterfacingNewSimp::MinisatInterfacingNewSimp(const Shell::Options& opts, bool generateProofs,
+    bool eliminateVariables):
   _status(SATISFIABLE)
 {
   CALL("MinisatInterfacingNewSimp::MinisatInterfacingNewSimp");
+
+  _solver.use_elim = eliminateVariables;
    
   // TODO: consider tuning minisat's options to be set for _solver
   // (or even forwarding them to vampire's options)  
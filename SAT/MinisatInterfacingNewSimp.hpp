@@ -35,7 +35,13 @@ public:
   
   static const unsigned VAR_MAX;
 
-	MinisatInterfacingNewSimp(const Shell::Options& opts, bool generateProofs=false);
+  /**
+   * If @b eliminateVariables is false, the solver does not eliminate
+   * variables during its simplification, so that clauses over any of
+   * the variables can still be added after a call to solve.
+   */
+	MinisatInterfacingNewSimp(const Shell::Options& opts, bool generateProofs=false,
+	    bool eliminateVariables=true);
 
   /**
    * Can be called only when all assumptions are retracted
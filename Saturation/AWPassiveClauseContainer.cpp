@@ -48,6 +48,7 @@ AWPassiveClauseContainer::AWPassiveClauseContainer(bool isOutermost, const Shell
   _weightRatio(opt.weightRatio()),
   _balance(0),
   _size(0),
+  _sizeLimit(isOutermost ? opt.passiveClauseLimit() : 0),
 
   _simulationBalance(0),
   _simulationCurrAgeIt(_ageQueue),
@@ -96,6 +97,16 @@ Comparison AWPassiveClauseContainer::compareWeight(Clause* cl1, Clause* cl2, con
   return Int::compare(cl1->weightForClauseSelection(opt), cl2->weightForClauseSelection(opt));
 }
 
+AgeQueue::AgeQueue(const Options& opt)
+  : ClauseQueue(opt.bucketClauseQueues()), _opt(opt)
+{
+}
+
+WeightQueue::WeightQueue(const Options& opt)
+  : ClauseQueue(opt.bucketClauseQueues()), _opt(opt)
+{
+}
+
 /**
  * Comparison of clauses. The comparison uses four orders in the
  * following order:
@@ -189,8 +200,59 @@ void AWPassiveClauseContainer::add(Clause* cl)
   {
     addedEvent.fire(cl);
   }
+
+  if (_sizeLimit && _size > _sizeLimit) {
+    enforceSizeLimit(cl);
+  }
 } // AWPassiveClauseContainer::add
 
+/**
+ * Discard the passive clauses that the clause selection would reach last,
+ * so that the container fits into the limit given by the passive_clause_limit
+ * option again.
+ *
+ * The clauses to keep are determined by the same simulation of the clause
+ * selection as used by the LRS. Somewhat more than the excess is removed, so that
+ * the (linear) pass over the container is not repeated on every addition.
+ * The clause @b added, which is still being processed by the caller, is kept.
+ */
+void AWPassiveClauseContainer::enforceSizeLimit(Clause* added)
+{
+  CALL("AWPassiveClauseContainer::enforceSizeLimit");
+  ASS(_isOutermost);
+
+  unsigned keep = _sizeLimit - _sizeLimit/8;
+
+  static Stack<Clause*> toRemove(256);
+  ASS(toRemove.isEmpty());
+
+  Clause::requestAux();
+
+  simulationInit();
+  for (unsigned i = 0; i < keep && simulationHasNext(); i++) {
+    simulationPopSelected();
+  }
+
+  // clauses not reached by the simulation are those selected last
+  ClauseQueue& queue = _weightRatio ? static_cast<ClauseQueue&>(_weightQueue) : _ageQueue;
+  ClauseQueue::Iterator cit(queue);
+  while (cit.hasNext()) {
+    Clause* cl=cit.next();
+    if (!cl->hasAux() && cl != added) {
+      toRemove.push(cl);
+    }
+  }
+
+  Clause::releaseAux();
+
+  while (toRemove.isNonEmpty()) {
+    Clause* removed=toRemove.pop();
+    RSTAT_CTR_INC("clauses discarded from passive on size limit");
+    env.statistics->discardedNonRedundantClauses++;
+    remove(removed);
+  }
+} // AWPassiveClauseContainer::enforceSizeLimit
+
 /**
  * Remove Clause from the Passive store. Should be called only
  * when the Clause is no longer needed by the inference process
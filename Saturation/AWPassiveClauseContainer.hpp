@@ -29,14 +29,27 @@ namespace Saturation {
 
 using namespace Kernel;
 
+/**
+ * Secondary key of the clause queues: @b key, and then the input type of
+ * @b c in decreasing order, as in AgeQueue::lessThan and WeightQueue::lessThan.
+ */
+inline unsigned long long inputTypeKey(Clause* c, unsigned key)
+{
+  return (static_cast<unsigned long long>(key) << 8) |
+    (255u - static_cast<unsigned>(c->inputType()));
+}
+
 class AgeQueue
 : public ClauseQueue
 {
 public:
-  AgeQueue(const Options& opt) : _opt(opt) {}
+  AgeQueue(const Options& opt);
 protected:
 
   virtual bool lessThan(Clause*,Clause*);
+  unsigned bucketKey(Clause* c) override { return c->age(); }
+  unsigned long long subBucketKey(Clause* c) override
+  { return inputTypeKey(c, c->weightForClauseSelection(_opt)); }
 
   friend class AWPassiveClauseContainer;
 
@@ -48,9 +61,12 @@ class WeightQueue
   : public ClauseQueue
 {
 public:
-  WeightQueue(const Options& opt) : _opt(opt) {}
+  WeightQueue(const Options& opt);
 protected:
   virtual bool lessThan(Clause*,Clause*);
+  unsigned bucketKey(Clause* c) override { return c->weightForClauseSelection(_opt); }
+  unsigned long long subBucketKey(Clause* c) override
+  { return inputTypeKey(c, c->age()); }
 
   friend class AWPassiveClauseContainer;
 private:
@@ -99,6 +115,10 @@ private:
   int _balance;
 
   unsigned _size;
+  /** maximal number of clauses kept in the container, 0 if unbounded */
+  unsigned _sizeLimit;
+
+  void enforceSizeLimit(Clause* added);
 
   /*
    * LRS specific methods and fields for computation of Limits
@@ -80,10 +80,23 @@ using namespace Shell;
  * The content of the @b units list after return from the function is
  * undefined
  *
+ * If @b keepProofState is true, the saturation algorithm with all its
+ * clauses and indices is not torn down when the proof attempt ends. This
+ * is meant for processes which terminate right after the attempt (such
+ * as portfolio slices), where releasing millions of clauses and index
+ * nodes one by one only delays the exit. The saturation algorithm and
+ * everything it owns are deliberately leaked, and the operating system
+ * reclaims their memory when the process exits. Static destructors and
+ * atexit handlers still run (a slice ends by exit()), but the destructors
+ * of the leaked objects never do. So a leaked object that holds resources
+ * other than memory, such as the ExternalSATSolver of the finite model
+ * builder with its child process and temporary files, must release them
+ * from a System termination handler (see ExternalSATSolver::onTermination).
+ *
  * The function does not necessarily return (e.g. in the case of timeout,
  * the process is aborted)
  */
-void ProvingHelper::runVampire(Problem& prb, const Options& opt)
+void ProvingHelper::runVampire(Problem& prb, const Options& opt, bool keepProofState)
 {
   CALL("ProvingHelper::runVampire");
 
@@ -96,7 +109,7 @@ void ProvingHelper::runVampire(Problem& prb, const Options& opt)
       Preprocess prepro(opt);
       prepro.preprocess(prb);
     }
-    runVampireSaturationImpl(prb, opt);
+    runVampireSaturationImpl(prb, opt, keepProofState);
   }
   catch(MemoryLimitExceededException&) {
     env.statistics->terminationReason=Statistics::MEMORY_LIMIT;
@@ -119,7 +132,7 @@ void ProvingHelper::runVampire(Problem& prb, const Options& opt)
  * Private version of the @b runVampireSaturation function
  * that is not protected for resource-limit exceptions
  */
-  void ProvingHelper::runVampireSaturationImpl(Problem& prb, const Options& opt)
+  void ProvingHelper::runVampireSaturationImpl(Problem& prb, const Options& opt, bool keepProofState)
 {
   CALL("ProvingHelper::runVampireSaturationImpl");
 
@@ -144,6 +157,13 @@ void ProvingHelper::runVampire(Problem& prb, const Options& opt)
   env.statistics->phase=Statistics::FINALIZATION;
   Timer::setTimeLimitEnforcement(false);
   sres.updateStatistics();
+
+  if (keepProofState) {
+    if (SaturationAlgorithm* sa = SaturationAlgorithm::tryGetInstance()) {
+      sa->abandon();
+    }
+    salg.release();
+  }
 }
 
 
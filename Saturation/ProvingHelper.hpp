@@ -25,9 +25,9 @@ using namespace Shell;
 class ProvingHelper {
 public:
   static void runVampireSaturation(Problem& prb, const Options& opt);
-  static void runVampire(Problem& prb, const Options& opt);
+  static void runVampire(Problem& prb, const Options& opt, bool keepProofState=false);
 private:
-  static void runVampireSaturationImpl(Problem& prb, const Options& opt);
+  static void runVampireSaturationImpl(Problem& prb, const Options& opt, bool keepProofState=false);
 };
 
 }
@@ -60,6 +60,7 @@
 #include "Inferences/ForwardDemodulation.hpp"
 #include "Inferences/ForwardLiteralRewriting.hpp"
 #include "Inferences/ForwardSubsumptionAndResolution.hpp"
+#include "Inferences/ForwardVariantElimination.hpp"
 #include "Inferences/ForwardSubsumptionDemodulation.hpp"
 #include "Inferences/GlobalSubsumption.hpp"
 #include "Inferences/HyperSuperposition.hpp"
@@ -252,6 +253,10 @@ SaturationAlgorithm::SaturationAlgorithm(Problem& prb, const Options& opt)
     _extensionality = 0;
   }
 
+  if (opt.deferredClauseDeletion()) {
+    Clause::setDeferredDestruction(true);
+  }
+
   s_instance=this;
 }
 
@@ -298,6 +303,40 @@ SaturationAlgorithm::~SaturationAlgorithm()
 
   delete _unprocessed;
   delete _active;
+
+  Clause::setDeferredDestruction(false);
+  releaseDeferredClauses();
+}
+
+/**
+ * Finish the run without destroying the object, which is then left
+ * to be reclaimed with the rest of the memory when the process exits.
+ *
+ * Like the destructor, release the deferred clauses (recording their
+ * statistics) and stop being the saturation algorithm in progress.
+ */
+void SaturationAlgorithm::abandon()
+{
+  CALL("SaturationAlgorithm::abandon");
+  ASS_EQ(s_instance,this);
+
+  s_instance=0;
+
+  Clause::setDeferredDestruction(false);
+  releaseDeferredClauses();
+}
+
+/**
+ * Destroy the clauses which became unnecessary since the last call,
+ * when deferred clause deletion is enabled.
+ */
+void SaturationAlgorithm::releaseDeferredClauses()
+{
+  CALL("SaturationAlgorithm::releaseDeferredClauses");
+
+  unsigned cnt;
+  env.statistics->deferredDeletedClauseBytes += Clause::destroyDeferred(cnt);
+  env.statistics->deferredDeletedClauses += cnt;
 }
 
 void SaturationAlgorithm::tryUpdateFinalClauseCount()
@@ -734,10 +773,19 @@ void SaturationAlgorithm::init()
 
   ClauseIterator toAdd = _prb.clauseIterator();
 
+  // set-of-support clauses go straight to the active container and nothing
+  // queries the indexes meanwhile, so they can be inserted together
+  bool batch=_opt.batchIndexUpdates() && _opt.sos()!=Options::Sos::OFF;
+  if (batch) {
+    _imgr->startBatch();
+  }
   while (toAdd.hasNext()) {
     Clause* cl=toAdd.next();
     addInputClause(cl);
   }
+  if (batch) {
+    _imgr->finishBatch();
+  }
 
   if (_splitter) {
     _splitter->init(this);
@@ -978,6 +1026,82 @@ bool SaturationAlgorithm::forwardSimplify(Clause* cl)
   return true;
 }
 
+/**
+ * Forward simplify up to @b batchSize clauses taken from the unprocessed
+ * container and add the surviving ones to passive.
+ *
+ * The result is the same as calling @b forwardSimplify on each of the
+ * clauses, except that the loops are swapped: each forward simplification
+ * engine is applied to the whole batch before the next one is tried, so
+ * that the index the engine uses stays in the cache. As the clauses are
+ * only added to passive once the whole batch has been simplified, they
+ * cannot simplify each other.
+ */
+void SaturationAlgorithm::forwardSimplifyBatch(unsigned batchSize)
+{
+  CALL("SaturationAlgorithm::forwardSimplifyBatch");
+
+  static ClauseStack batch;
+  batch.reset();
+
+  while (batch.size() < batchSize && !_unprocessed->isEmpty()) {
+    Clause* cl = _unprocessed->pop();
+    ASS(!isRefutation(cl));
+
+    if (!_passive->fulfilsAgeLimit(cl) && !_passive->fulfilsWeightLimit(cl)) {
+      RSTAT_CTR_INC("clauses discarded by weight limit in forward simplification");
+      env.statistics->discardedNonRedundantClauses++;
+      cl->setStore(Clause::NONE);
+      continue;
+    }
+    batch.push(cl);
+  }
+
+  FwSimplList::Iterator fsit(_fwSimplifiers);
+  while (fsit.hasNext() && batch.isNonEmpty()) {
+    ForwardSimplificationEngine* fse=fsit.next();
+
+    size_t kept = 0;
+    for (size_t i = 0; i < batch.size(); i++) {
+      Clause* cl = batch[i];
+      Clause* replacement = 0;
+      ClauseIterator premises = ClauseIterator::getEmpty();
+
+      if (fse->perform(cl,replacement,premises)) {
+        if (replacement) {
+          addNewClause(replacement);
+        }
+        onClauseReduction(cl, replacement, premises);
+
+        ASS_EQ(cl->store(), Clause::UNPROCESSED);
+        cl->setStore(Clause::NONE);
+        continue;
+      }
+      batch[kept++] = cl;
+    }
+    batch.truncate(kept);
+  }
+
+  for (size_t i = 0; i < batch.size(); i++) {
+    Clause* cl = batch[i];
+
+    //the same hack as in forwardSimplify
+    cl->incRefCnt();
+
+    if ( _splitter && !_opt.splitAtActivation() ) {
+      if (_splitter->doSplitting(cl)) {
+        ASS_EQ(cl->store(), Clause::UNPROCESSED);
+        cl->setStore(Clause::NONE);
+        continue;
+      }
+    }
+
+    onClauseRetained(cl);
+    addToPassive(cl);
+    ASS_EQ(cl->store(), Clause::PASSIVE);
+  }
+}
+
 /**
  * The the backward simplification with the clause @b cl.
  */
@@ -992,6 +1116,12 @@ void SaturationAlgorithm::backwardSimplify(Clause* cl)
 
     BwSimplificationRecordIterator simplifications;
     bse->perform(cl,simplifications);
+    // the simplifications have been computed at this point, so the
+    // removals from indexes can wait until all of them are done
+    bool batch=_opt.batchIndexUpdates() && simplifications.hasNext();
+    if (batch) {
+      _imgr->startBatch();
+    }
     while (simplifications.hasNext()) {
       BwSimplificationRecord srec=simplifications.next();
       Clause* redundant=srec.toRemove;
@@ -1014,6 +1144,9 @@ void SaturationAlgorithm::backwardSimplify(Clause* cl)
 
       redundant->decRefCnt();
     }
+    if (batch) {
+      _imgr->finishBatch();
+    }
   }
 }
 
@@ -1130,6 +1263,12 @@ bool SaturationAlgorithm::activate(Clause* cl)
 
       addNewClause(genCl);
 
+      // parenthood is only reported to the symbol elimination output,
+      // don't walk the premises of every generated clause otherwise
+      if (!_symEl) {
+        continue;
+      }
+
       Inference::Iterator iit=genCl->inference().iterator();
       while (genCl->inference().hasNext(iit)) {
         Unit* premUnit=genCl->inference().next(iit);
@@ -1147,6 +1286,10 @@ bool SaturationAlgorithm::activate(Clause* cl)
 
 
   //now we remove clauses that could not be removed during the clause activation process
+  bool batch=_opt.batchIndexUpdates() && _postponedClauseRemovals.isNonEmpty();
+  if (batch) {
+    _imgr->startBatch();
+  }
   while (_postponedClauseRemovals.isNonEmpty()) {
     Clause* cl=_postponedClauseRemovals.pop();
     if (cl->store() != Clause::ACTIVE &&
@@ -1155,6 +1298,9 @@ bool SaturationAlgorithm::activate(Clause* cl)
     }
     removeActiveOrPassiveClause(cl);
   }
+  if (batch) {
+    _imgr->finishBatch();
+  }
 
   return true; 
 }
@@ -1171,6 +1317,15 @@ start:
   newClausesToUnprocessed();
 
   while (! _unprocessed->isEmpty()) {
+    if (_opt.forwardSimplificationBatch() > 1) {
+      forwardSimplifyBatch(_opt.forwardSimplificationBatch());
+      newClausesToUnprocessed();
+      if (env.timeLimitReached()) {
+        throw TimeLimitExceededException();
+      }
+      continue;
+    }
+
     Clause* c = _unprocessed->pop();
     ASS(!isRefutation(c));
 
@@ -1256,6 +1411,12 @@ void SaturationAlgorithm::doOneAlgorithmStep()
 {
   CALL("SaturationAlgorithm::doOneAlgorithmStep");
 
+  // the start of an iteration is a safe point: the clauses deleted
+  // during the previous one are no longer referenced from the stack
+  if (_opt.deferredClauseDeletion()) {
+    releaseDeferredClauses();
+  }
+
   doUnprocessedLoop();
 
   if (_passive->isEmpty()) {
@@ -1540,6 +1701,10 @@ SaturationAlgorithm* SaturationAlgorithm::createFromOptions(Problem& prb, const
   else if (opt.forwardSubsumptionResolution()) {
     USER_ERROR("Forward subsumption resolution requires forward subsumption to be enabled.");
   }
+  if (opt.forwardVariantElimination()) {
+    // cheaper than any other forward simplification, so it goes first
+    res->addForwardSimplifierToFront(new ForwardVariantElimination());
+  }
 
   // create backward simplification engine
   if (prb.hasEquality()) {
@@ -118,6 +118,8 @@ public:
   static SaturationAlgorithm* tryGetInstance() { return s_instance; }
   static void tryUpdateFinalClauseCount();
 
+  void abandon();
+
   Splitter* getSplitter() { return _splitter; }
 
 protected:
@@ -130,6 +132,8 @@ protected:
   void newClausesToUnprocessed();
   void addUnprocessedClause(Clause* cl);
   bool forwardSimplify(Clause* c);
+  void forwardSimplifyBatch(unsigned batchSize);
+  void releaseDeferredClauses();
   void backwardSimplify(Clause* c);
   void addToPassive(Clause* c);
   bool activate(Clause* c);
@@ -115,6 +115,10 @@ void SplittingBranchSelector::init()
       _dpModel = new DP::SimpleCongruenceClosure(&_parent.getOrdering());
     }
   }
+
+  // the repaired model is not checked by the decision procedure nor by an SMT solver
+  _modelRepair = _parent.getOptions().splittingModelRepair() && !_dp &&
+      _parent.getOptions().satSolver() == Options::SatSolver::MINISAT;
 }
 
 void SplittingBranchSelector::updateVarCnt()
@@ -567,6 +571,10 @@ void SplittingBranchSelector::addSatClauseToSolver(SATClause* cl, bool branchRef
 
   RSTAT_CTR_INC("ssat_sat_clauses");
 
+  if (_modelRepair) {
+    _newClauses.push(cl);
+  }
+
   if (branchRefutation && _minSCO) {
     _solver->addClauseIgnoredInPartialModel(cl);
   } else {
@@ -574,12 +582,74 @@ void SplittingBranchSelector::addSatClauseToSolver(SATClause* cl, bool branchRef
   }
 }
 
+/**
+ * Try to extend the current model to the clauses added since the last call
+ * to the SAT solver. A clause not yet true is made true by a variable introduced
+ * after that call, as these do not occur in the older clauses. Only the selection
+ * of the variables assigned here is updated.
+ *
+ * Return false if some clause cannot be made true this way, the model is
+ * then left as it was.
+ */
+bool SplittingBranchSelector::tryRepairModel(SplitLevelStack& addedComps, SplitLevelStack& removedComps)
+{
+  CALL("SplittingBranchSelector::tryRepairModel");
+  ASS(_modelValid);
+
+  _model.expand(_parent.maxSatVar()+1,SATSolver::DONT_CARE);
+
+  static Stack<unsigned> assigned;
+  assigned.reset();
+
+  SATClauseStack::Iterator it(_newClauses);
+  while(it.hasNext()) {
+    SATClause* cl = it.next();
+
+    bool isTrue = false;
+    for(unsigned i=0; !isTrue && i<cl->length(); i++) {
+      SATLiteral lit = (*cl)[i];
+      isTrue = _model[lit.var()] == (lit.polarity() ? SATSolver::TRUE : SATSolver::FALSE);
+    }
+    for(unsigned i=0; !isTrue && i<cl->length(); i++) {
+      SATLiteral lit = (*cl)[i];
+      if (lit.var() > _modelVarCnt && _model[lit.var()] == SATSolver::DONT_CARE) {
+        _model[lit.var()] = lit.polarity() ? SATSolver::TRUE : SATSolver::FALSE;
+        assigned.push(lit.var());
+        isTrue = true;
+      }
+    }
+
+    if(!isTrue) {
+      Stack<unsigned>::Iterator ait(assigned);
+      while(ait.hasNext()) {
+        _model[ait.next()] = SATSolver::DONT_CARE;
+      }
+      return false;
+    }
+  }
+  _newClauses.reset();
+
+  Stack<unsigned>::Iterator ait(assigned);
+  while(ait.hasNext()) {
+    unsigned var = ait.next();
+    updateSelection(var, _model[var], addedComps, removedComps);
+  }
+  return true;
+}
+
 void SplittingBranchSelector::recomputeModel(SplitLevelStack& addedComps, SplitLevelStack& removedComps, bool randomize)
 {
   CALL("SplittingBranchSelector::recomputeModel");
   ASS(addedComps.isEmpty());
   ASS(removedComps.isEmpty());
 
+  if (_modelRepair && _modelValid && !randomize && tryRepairModel(addedComps, removedComps)) {
+    env.statistics->satSplitModelRepairs++;
+    env.statistics->satSplitComponentFlips += addedComps.size()+removedComps.size();
+    return;
+  }
+  _newClauses.reset();
+
   unsigned maxSatVar = _parent.maxSatVar();
   
   SATSolver::Status stat;
@@ -602,6 +672,10 @@ void SplittingBranchSelector::recomputeModel(SplitLevelStack& addedComps, SplitL
   }
   ASS_EQ(stat,SATSolver::SATISFIABLE);
 
+  if (_modelRepair) {
+    _model.expand(maxSatVar+1);
+  }
+
   unsigned _usedcnt=0; // for the statistics below
   for(unsigned i=1; i<=maxSatVar; i++) {
     SATSolver::VarAssignment asgn = getSolverAssimentConsideringCCModel(i);
@@ -621,7 +695,15 @@ void SplittingBranchSelector::recomputeModel(SplitLevelStack& addedComps, SplitL
     if (asgn != SATSolver::DONT_CARE) {
       _usedcnt++;
     }
+    if (_modelRepair) {
+      _model[i] = asgn;
+    }
+  }
+  if (_modelRepair) {
+    _modelValid = true;
+    _modelVarCnt = maxSatVar;
   }
+  env.statistics->satSplitComponentFlips += addedComps.size()+removedComps.size();
   /*
   if(maxSatVar>=1){
     int percent = (_usedcnt *100) / maxSatVar;
@@ -640,7 +722,7 @@ void SplittingBranchSelector::recomputeModel(SplitLevelStack& addedComps, SplitL
 vstring Splitter::splPrefix = "";
 
 Splitter::Splitter()
-: _deleteDeactivated(Options::SplittingDeleteDeactivated::ON), _branchSelector(*this),
+: _deleteDeactivated(Options::SplittingDeleteDeactivated::ON), _batchIndexUpdates(false), _branchSelector(*this),
   _clausesAdded(false), _haveBranchRefutation(false)
 {
   CALL("Splitter::Splitter");
@@ -703,6 +785,7 @@ void Splitter::init(SaturationAlgorithm* sa)
 
   _fastRestart = opts.splittingFastRestart();
   _deleteDeactivated = opts.splittingDeleteDeactivated();
+  _batchIndexUpdates = opts.batchIndexUpdates();
 
   if (opts.useHashingVariantIndex()) {
     _componentIdx = new HashingClauseVariantIndex();
@@ -1697,7 +1780,7 @@ void Splitter::addComponents(const SplitLevelStack& toAdd)
       while (chit.hasNext()) {
         Clause* cl = chit.next();
         cl->incNumActiveSplits();
-        if (cl->getNumActiveSplits() == (int)cl->splits()->size()) {
+        if (cl->getNumActiveSplits() == Clause::allActiveSplits(cl->splits()->size())) {
           reactivated_cnt++;
           _sa->addNewClause(cl);
           //check that restored clause does not depend on inactive splits
@@ -1722,6 +1805,12 @@ void Splitter::removeComponents(const SplitLevelStack& toRemove)
   
   SplitSet* backtracked = SplitSet::getFromArray(toRemove.begin(), toRemove.size());
 
+  // the children to be removed from _sa, collected over all the backtracked
+  // levels first, so that they are removed in one pass (with the index
+  // removals batched if enabled); a child may be collected more than once
+  static RCClauseStack toDetach;
+  ASS(toDetach.isEmpty());
+
   // ensure all children are backtracked
   // i.e. removed from _sa and reference counter dec
   SplitSet::Iterator blit(*backtracked);
@@ -1735,8 +1824,7 @@ void Splitter::removeComponents(const SplitLevelStack& toRemove)
       Clause* ccl=chit.next();
       ASS(ccl->splits()->member(bl));
       if(ccl->store()!=Clause::NONE) {
-        _sa->removeActiveOrPassiveClause(ccl);
-        ASS_EQ(ccl->store(), Clause::NONE);
+        toDetach.push(ccl);
       }
       ccl->invalidateMyReductionRecords();
       ccl->decNumActiveSplits();
@@ -1751,6 +1839,22 @@ void Splitter::removeComponents(const SplitLevelStack& toRemove)
     }
   }
 
+  bool batch = _batchIndexUpdates && toDetach.isNonEmpty();
+  if (batch) {
+    _sa->getIndexManager()->startBatch();
+  }
+  while(toDetach.isNonEmpty()) {
+    Clause* ccl=toDetach.popWithoutDec();
+    if(ccl->store()!=Clause::NONE) {
+      _sa->removeActiveOrPassiveClause(ccl);
+      ASS_EQ(ccl->store(), Clause::NONE);
+    }
+    ccl->decRefCnt(); //belongs to toDetach.popWithoutDec()
+  }
+  if (batch) {
+    _sa->getIndexManager()->finishBatch();
+  }
+
   // perform unfreezing  
     
   // pick all reduced clauses (if the record relates to most recent reduction)
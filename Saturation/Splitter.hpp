@@ -19,6 +19,7 @@
 
 #include "Lib/Allocator.hpp"
 #include "Lib/ArrayMap.hpp"
+#include "Lib/DArray.hpp"
 #include "Lib/DHMap.hpp"
 #include "Lib/Stack.hpp"
 #include "Lib/ScopedPtr.hpp"
@@ -56,7 +57,7 @@ class Splitter;
  */
 class SplittingBranchSelector {
 public:
-  SplittingBranchSelector(Splitter& parent) : _ccModel(false), _parent(parent)  {}
+  SplittingBranchSelector(Splitter& parent) : _ccModel(false), _modelRepair(false), _parent(parent), _modelValid(false), _modelVarCnt(0)  {}
   ~SplittingBranchSelector(){
 #if VZ3
 {
@@ -80,6 +81,7 @@ _solver=0;
 private:
   SATSolver::Status processDPConflicts();
   SATSolver::VarAssignment getSolverAssimentConsideringCCModel(unsigned var);
+  bool tryRepairModel(SplitLevelStack& addedComps, SplitLevelStack& removedComps);
 
   void handleSatRefutation();
   void updateSelection(unsigned satVar, SATSolver::VarAssignment asgn,
@@ -93,6 +95,7 @@ private:
   bool _ccMultipleCores;
   bool _minSCO; // minimize wrt splitting clauses only
   bool _ccModel;
+  bool _modelRepair;
 
   Splitter& _parent;
 
@@ -111,6 +114,16 @@ private:
    */
   ArraySet _trueInCCModel;
 
+  /**
+   * For the model repair: the model the selection corresponds to (indexed by var),
+   * whether there is one, the variables assigned by the last call to the solver,
+   * and the clauses added since.
+   */
+  DArray<SATSolver::VarAssignment> _model;
+  bool _modelValid;
+  unsigned _modelVarCnt;
+  SATClauseStack _newClauses;
+
 #if VDEBUG
   unsigned lastCheckedVar;
 #endif
@@ -250,6 +263,7 @@ private:
   float _flushQuotient;
   Options::SplittingDeleteDeactivated _deleteDeactivated;
   Options::SplittingCongruenceClosure _congruenceClosure;
+  bool _batchIndexUpdates;
 #if VZ3
   bool hasSMTSolver;
 #endif
@@ -823,6 +823,23 @@ void Options::init()
     _lookup.insert(&_fmbEnumerationStrategy);
     _fmbEnumerationStrategy.tag(OptionTag::FMB);
 
+    _fmbIncremental = BoolOptionValue("fmb_incremental","fmbi",false);
+    _fmbIncremental.description = "Keep the SAT solver and the constraints already generated when the model sizes grow, instead of encoding each size vector from scratch.";
+    _fmbIncremental.reliesOn(_fmbEnumerationStrategy.is(equal(FMBEnumerationStrategy::CONTOUR)));
+    _lookup.insert(&_fmbIncremental);
+    _fmbIncremental.tag(OptionTag::FMB);
+
+    _fmbExternalSatSolver = StringOptionValue("fmb_external_sat_solver","fmbess","");
+    _fmbExternalSatSolver.description = "If set, this command is used as the SAT solver instead of minisat. It is run without a shell, with its arguments separated by spaces (which can be quoted or escaped by a backslash) and a DIMACS file as its last argument, and must print the result in the format of the SAT competition.";
+    _lookup.insert(&_fmbExternalSatSolver);
+    _fmbExternalSatSolver.tag(OptionTag::FMB);
+
+    _fmbDimacsFile = StringOptionValue("fmb_dimacs_file","fmbdf","");
+    _fmbDimacsFile.description = "The file the DIMACS problems for the external SAT solver are written to. It is kept and holds the last problem. By default a temporary file is used.";
+    _fmbDimacsFile.reliesOn(_fmbExternalSatSolver.is(notEqual(vstring(""))));
+    _lookup.insert(&_fmbDimacsFile);
+    _fmbDimacsFile.tag(OptionTag::FMB);
+
     _selection = SelectionOptionValue("selection","s",10);
     _selection.description=
     "Selection methods 2,3,4,10,11 are complete by virtue of extending Maximal i.e. they select the best among maximal. Methods 1002,1003,1004,1010,1011 relax this restriction and are therefore not complete.\n"
@@ -982,6 +999,73 @@ void Options::init()
     _lookup.insert(&_literalMaximalityAftercheck);
     _literalMaximalityAftercheck.tag(OptionTag::SATURATION);
 
+    _forwardSimplificationBatch = UnsignedOptionValue("forward_simplification_batch","fsb",1);
+    _forwardSimplificationBatch.description=
+    "Number of unprocessed clauses that are forward simplified together. Each forward simplification rule is applied to "
+    "the whole batch before moving on to the next rule, which keeps the rule's index hot in the cache; the surviving "
+    "clauses are then added to passive one by one. Clauses of one batch are not used to simplify each other.";
+    _lookup.insert(&_forwardSimplificationBatch);
+    _forwardSimplificationBatch.tag(OptionTag::SATURATION);
+    _forwardSimplificationBatch.addConstraint(greaterThan(0u));
+
+    _deferredClauseDeletion = BoolOptionValue("deferred_clause_deletion","dcd",false);
+    _deferredClauseDeletion.description=
+    "Clauses which become unnecessary during one iteration of the saturation loop are not destroyed immediately, "
+    "but released together at the start of the next iteration.";
+    _lookup.insert(&_deferredClauseDeletion);
+    _deferredClauseDeletion.tag(OptionTag::SATURATION);
+
+    _passiveClauseLimit = UnsignedOptionValue("passive_clause_limit","pcl",0);
+    _passiveClauseLimit.description=
+    "Upper bound on the number of clauses kept in the passive container (0 means unlimited). When the bound is exceeded, "
+    "the clauses that the clause selection would reach last are discarded, which makes the search incomplete.";
+    _lookup.insert(&_passiveClauseLimit);
+    _passiveClauseLimit.tag(OptionTag::SATURATION);
+
+    _bucketClauseQueues = BoolOptionValue("bucket_clause_queues","bcq",false);
+    _bucketClauseQueues.description=
+    "Organise the age and weight queues of the passive container as arrays of buckets indexed by clause age and weight, "
+    "respectively, instead of skip lists. The order in which clauses are selected is the same.";
+    _lookup.insert(&_bucketClauseQueues);
+    _bucketClauseQueues.tag(OptionTag::SATURATION);
+
+    _demodulationLhsIndex = ChoiceOptionValue<TermIndex>("demodulation_lhs_index","dli",TermIndex::CODE_TREE,
+                                                         {"substitution_tree","code_tree","discrimination_tree","fingerprint"});
+    _demodulationLhsIndex.description=
+    "The indexing structure storing the left-hand sides of unit equalities, from which generalizations of "
+    "subterms are retrieved for forward demodulation.";
+    _demodulationLhsIndex.setExperimental();
+    _lookup.insert(&_demodulationLhsIndex);
+    _demodulationLhsIndex.tag(OptionTag::SATURATION);
+
+    _demodulationSubtermIndex = ChoiceOptionValue<TermIndex>("demodulation_subterm_index","dsi",TermIndex::SUBSTITUTION_TREE,
+                                                             {"substitution_tree","code_tree","discrimination_tree","fingerprint"});
+    _demodulationSubtermIndex.description=
+    "The indexing structure storing subterms of active clauses, from which instances are retrieved for backward demodulation.";
+    _demodulationSubtermIndex.addConstraint(notEqual(TermIndex::CODE_TREE));
+    _demodulationSubtermIndex.setExperimental();
+    _lookup.insert(&_demodulationSubtermIndex);
+    _demodulationSubtermIndex.tag(OptionTag::SATURATION);
+
+    _superpositionIndex = ChoiceOptionValue<TermIndex>("superposition_index","spi",TermIndex::SUBSTITUTION_TREE,
+                                                       {"substitution_tree","code_tree","discrimination_tree","fingerprint"});
+    _superpositionIndex.description=
+    "The indexing structure storing rewritable subterms and left-hand sides of equalities for superposition. "
+    "Unification with abstraction always uses substitution trees.";
+    _superpositionIndex.addConstraint(notEqual(TermIndex::CODE_TREE));
+    _superpositionIndex.setExperimental();
+    _lookup.insert(&_superpositionIndex);
+    _superpositionIndex.tag(OptionTag::SATURATION);
+
+    _batchIndexUpdates = BoolOptionValue("batch_index_updates","biu",false);
+    _batchIndexUpdates.description=
+    "Update the indexes together with the clauses removed by one backward simplification, postponed during a clause "
+    "activation, or deactivated by a change of the AVATAR model, and with the input set-of-support clauses. "
+    "Substitution trees sort such insertions and removals by their terms, and code trees remove large batches "
+    "of entries in one pass.";
+    _lookup.insert(&_batchIndexUpdates);
+    _batchIndexUpdates.tag(OptionTag::SATURATION);
+
       _lrsFirstTimeCheck = IntOptionValue("lrs_first_time_check","",5);
       _lrsFirstTimeCheck.description=
       "Percentage of time limit at which the LRS algorithm will for the first time estimate the number of reachable clauses.";
@@ -1332,6 +1416,12 @@ void Options::init()
     _forwardSubsumption.tag(OptionTag::INFERENCES);
     _forwardSubsumption.setRandomChoices({"on","on","on","on","on","on","on","on","on","off"}); // turn this off rarely
 
+    _forwardVariantElimination = BoolOptionValue("forward_variant_elimination","fve",false);
+    _forwardVariantElimination.description="Delete new clauses that are variants of retained clauses before they reach passive. "
+      "Variants are found by hashing of the clauses, which is cheaper than forward subsumption.";
+    _lookup.insert(&_forwardVariantElimination);
+    _forwardVariantElimination.tag(OptionTag::INFERENCES);
+
     _forwardSubsumptionResolution = BoolOptionValue("forward_subsumption_resolution","fsr",true);
     _forwardSubsumptionResolution.description="Perform forward subsumption resolution.";
     _lookup.insert(&_forwardSubsumptionResolution);
@@ -1601,6 +1691,12 @@ void Options::init()
     _splittingBufferedSolver.reliesOn(_splitting.is(equal(true)));
     _splittingBufferedSolver.setRandomChoices({"on","off"});
 
+    _splittingModelRepair = BoolOptionValue("avatar_model_repair","amr",false);
+    _splittingModelRepair.description="Before calling the SAT solver, try to extend the current model to the new SAT clauses by assigning only the variables introduced since the last solver call, and update only the components of these variables. Ignored with congruence closure and with the z3 solver.";
+    _lookup.insert(&_splittingModelRepair);
+    _splittingModelRepair.tag(OptionTag::AVATAR);
+    _splittingModelRepair.reliesOn(_splitting.is(equal(true)));
+
     _splittingDeleteDeactivated = ChoiceOptionValue<SplittingDeleteDeactivated>("avatar_delete_deactivated","add",
                                                                         SplittingDeleteDeactivated::ON,{"on","large","off"});
 
@@ -1801,6 +1897,15 @@ void Options::init()
     _kboAdmissabilityCheck.reliesOn(_termOrdering.is(equal(TermOrdering::KBO)));
     _lookup.insert(&_kboAdmissabilityCheck);
 
+    _orderingComparisonCache = UnsignedOptionValue("ordering_comparison_cache","occ",14);
+    _orderingComparisonCache.description=
+    "Binary logarithm of the number of entries of the cache in which the term ordering keeps results of comparisons "
+    "of shared terms. The cache is direct-mapped, so colliding entries overwrite each other. 0 disables the cache.";
+    _orderingComparisonCache.addConstraint(lessThanEq(24u));
+    _orderingComparisonCache.setExperimental();
+    _lookup.insert(&_orderingComparisonCache);
+    _orderingComparisonCache.tag(OptionTag::SATURATION);
+
 
     _functionWeights = StringOptionValue("function_weights","fw","");
     _functionWeights.description = 
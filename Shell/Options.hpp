@@ -694,6 +694,13 @@ public:
     WARNING = 1,
   };
 
+  enum class TermIndex : unsigned int {
+    SUBSTITUTION_TREE = 0,
+    CODE_TREE = 1,
+    DISCRIMINATION_TREE = 2,
+    FINGERPRINT = 3,
+  };
+
     //==========================================================
     // The Internals
     //==========================================================
@@ -1897,6 +1904,9 @@ public:
   unsigned fmbDetectSortBoundsTimeLimit() const { return _fmbDetectSortBoundsTimeLimit.actualValue; }
   unsigned fmbSizeWeightRatio() const { return _fmbSizeWeightRatio.actualValue; }
   FMBEnumerationStrategy fmbEnumerationStrategy() const { return _fmbEnumerationStrategy.actualValue; }
+  bool fmbIncremental() const { return _fmbIncremental.actualValue; }
+  vstring fmbExternalSatSolver() const { return _fmbExternalSatSolver.actualValue; }
+  vstring fmbDimacsFile() const { return _fmbDimacsFile.actualValue; }
 
   bool flattenTopLevelConjunctions() const { return _flattenTopLevelConjunctions.actualValue; }
   LTBLearning ltbLearning() const { return _ltbLearning.actualValue; }
@@ -2008,6 +2018,7 @@ public:
   bool backwardSubsumptionDemodulation() const { return _backwardSubsumptionDemodulation.actualValue; }
   unsigned backwardSubsumptionDemodulationMaxMatches() const { return _backwardSubsumptionDemodulationMaxMatches.actualValue; }
   bool forwardSubsumption() const { return _forwardSubsumption.actualValue; }
+  bool forwardVariantElimination() const { return _forwardVariantElimination.actualValue; }
   bool forwardLiteralRewriting() const { return _forwardLiteralRewriting.actualValue; }
   int lrsFirstTimeCheck() const { return _lrsFirstTimeCheck.actualValue; }
   int lrsWeightLimitOnly() const { return _lrsWeightLimitOnly.actualValue; }
@@ -2020,6 +2031,7 @@ public:
   SymbolPrecedenceBoost symbolPrecedenceBoost() const { return _symbolPrecedenceBoost.actualValue; }
   IntroducedSymbolPrecedence introducedSymbolPrecedence() const { return _introducedSymbolPrecedence.actualValue; }
   const KboAdmissibilityCheck kboAdmissabilityCheck() const { return _kboAdmissabilityCheck.actualValue; }
+  unsigned orderingComparisonCache() const { return _orderingComparisonCache.actualValue; }
   const vstring& functionWeights() const { return _functionWeights.actualValue; }
   const vstring& predicateWeights() const { return _predicateWeights.actualValue; }
   const vstring& functionPrecedence() const { return _functionPrecedence.actualValue; }
@@ -2056,6 +2068,14 @@ public:
 	AgeWeightRatioShape ageWeightRatioShape() const { return _ageWeightRatioShape.actualValue; }
 	int ageWeightRatioShapeFrequency() const { return _ageWeightRatioShapeFrequency.actualValue; }
   bool literalMaximalityAftercheck() const { return _literalMaximalityAftercheck.actualValue; }
+  unsigned forwardSimplificationBatch() const { return _forwardSimplificationBatch.actualValue; }
+  bool deferredClauseDeletion() const { return _deferredClauseDeletion.actualValue; }
+  unsigned passiveClauseLimit() const { return _passiveClauseLimit.actualValue; }
+  bool bucketClauseQueues() const { return _bucketClauseQueues.actualValue; }
+  TermIndex demodulationLhsIndex() const { return _demodulationLhsIndex.actualValue; }
+  TermIndex demodulationSubtermIndex() const { return _demodulationSubtermIndex.actualValue; }
+  TermIndex superpositionIndex() const { return _superpositionIndex.actualValue; }
+  bool batchIndexUpdates() const { return _batchIndexUpdates.actualValue; }
   bool superpositionFromVariables() const { return _superpositionFromVariables.actualValue; }
   EqualityProxy equalityProxy() const { return _equalityProxy.actualValue; }
   RuleActivity equalityResolutionWithDeletion() const { return _equalityResolutionWithDeletion.actualValue; }
@@ -2154,6 +2174,7 @@ public:
   SplittingDeleteDeactivated splittingDeleteDeactivated() const { return _splittingDeleteDeactivated.actualValue;}
   bool splittingFastRestart() const { return _splittingFastRestart.actualValue; }
   bool splittingBufferedSolver() const { return _splittingBufferedSolver.actualValue; }
+  bool splittingModelRepair() const { return _splittingModelRepair.actualValue; }
   int splittingFlushPeriod() const { return _splittingFlushPeriod.actualValue; }
   float splittingFlushQuotient() const { return _splittingFlushQuotient.actualValue; }
   bool splittingEagerRemoval() const { return _splittingEagerRemoval.actualValue; }
@@ -2314,6 +2335,14 @@ private:
   StringOptionValue _positiveLiteralSplitQueueCutoffs;
   BoolOptionValue _positiveLiteralSplitQueueLayeredArrangement;
   BoolOptionValue _literalMaximalityAftercheck;
+  UnsignedOptionValue _forwardSimplificationBatch;
+  BoolOptionValue _deferredClauseDeletion;
+  UnsignedOptionValue _passiveClauseLimit;
+  BoolOptionValue _bucketClauseQueues;
+  ChoiceOptionValue<TermIndex> _demodulationLhsIndex;
+  ChoiceOptionValue<TermIndex> _demodulationSubtermIndex;
+  ChoiceOptionValue<TermIndex> _superpositionIndex;
+  BoolOptionValue _batchIndexUpdates;
   BoolOptionValue _arityCheck;
   
   BoolOptionValue _backjumpTargetIsDecisionPoint;
@@ -2363,6 +2392,9 @@ private:
   UnsignedOptionValue _fmbDetectSortBoundsTimeLimit;
   UnsignedOptionValue _fmbSizeWeightRatio;
   ChoiceOptionValue<FMBEnumerationStrategy> _fmbEnumerationStrategy;
+  BoolOptionValue _fmbIncremental;
+  StringOptionValue _fmbExternalSatSolver;
+  StringOptionValue _fmbDimacsFile;
 
   BoolOptionValue _flattenTopLevelConjunctions;
   StringOptionValue _forbiddenOptions;
@@ -2374,6 +2406,7 @@ private:
   BoolOptionValue _forwardSubsumptionResolution;
   BoolOptionValue _forwardSubsumptionDemodulation;
   UnsignedOptionValue _forwardSubsumptionDemodulationMaxMatches;
+  BoolOptionValue _forwardVariantElimination;
   ChoiceOptionValue<FunctionDefinitionElimination> _functionDefinitionElimination;
   IntOptionValue _functionNumber;
   
@@ -2536,6 +2569,7 @@ private:
   ChoiceOptionValue<SplittingDeleteDeactivated> _splittingDeleteDeactivated;
   BoolOptionValue _splittingFastRestart;
   BoolOptionValue _splittingBufferedSolver;
+  BoolOptionValue _splittingModelRepair;
 
   ChoiceOptionValue<Statistics> _statistics;
   BoolOptionValue _superpositionFromVariables;
@@ -2544,6 +2578,7 @@ private:
   ChoiceOptionValue<SymbolPrecedenceBoost> _symbolPrecedenceBoost;
   ChoiceOptionValue<IntroducedSymbolPrecedence> _introducedSymbolPrecedence;
   ChoiceOptionValue<KboAdmissibilityCheck> _kboAdmissabilityCheck;
+  UnsignedOptionValue _orderingComparisonCache;
   StringOptionValue _functionWeights;
   StringOptionValue _predicateWeights;
   StringOptionValue _functionPrecedence;
@@ -104,6 +104,7 @@ Statistics::Statistics()
     simpleTautologies(0),
     equationalTautologies(0),
     forwardSubsumed(0),
+    forwardVariantsEliminated(0),
     backwardSubsumed(0),
     taDistinctnessSimplifications(0),
     taDistinctnessTautologyDeletions(0),
@@ -115,7 +116,11 @@ Statistics::Statistics()
     activeClauses(0),
     extensionalityClauses(0),
     discardedNonRedundantClauses(0),
+    deferredDeletedClauses(0),
+    deferredDeletedClauseBytes(0),
     inferencesBlockedForOrderingAftercheck(0),
+    orderingCacheLookups(0),
+    orderingCacheHits(0),
     smtReturnedUnknown(false),
     smtDidNotEvaluate(false),
     inferencesSkippedDueToColors(0),
@@ -131,6 +136,8 @@ Statistics::Statistics()
 
     satSplits(0),
     satSplitRefutations(0),
+    satSplitModelRepairs(0),
+    satSplitComponentFlips(0),
 
     smtFallbacks(0),
 
@@ -267,6 +274,8 @@ void Statistics::print(ostream& out)
   COND_OUT("Discarded non-redundant clauses", discardedNonRedundantClauses);
   COND_OUT("Inferences skipped due to colors", inferencesSkippedDueToColors);
   COND_OUT("Inferences blocked due to ordering aftercheck", inferencesBlockedForOrderingAftercheck);
+  COND_OUT("Ordering comparison cache lookups", orderingCacheLookups);
+  COND_OUT("Ordering comparison cache hits", orderingCacheHits);
   SEPARATOR;
 
 
@@ -292,13 +301,14 @@ void Statistics::print(ostream& out)
   SEPARATOR;
 
   HEADING("Deletion Inferences",simpleTautologies+equationalTautologies+
-      forwardSubsumed+backwardSubsumed+forwardDemodulationsToEqTaut+
+      forwardSubsumed+forwardVariantsEliminated+backwardSubsumed+forwardDemodulationsToEqTaut+
       forwardSubsumptionDemodulationsToEqTaut+backwardSubsumptionDemodulationsToEqTaut+
       backwardDemodulationsToEqTaut+innerRewritesToEqTaut);
   COND_OUT("Simple tautologies", simpleTautologies);
   COND_OUT("Equational tautologies", equationalTautologies);
   COND_OUT("Deep equational tautologies", deepEquationalTautologies);
   COND_OUT("Forward subsumptions", forwardSubsumed);
+  COND_OUT("Forward variant eliminations", forwardVariantsEliminated);
   COND_OUT("Backward subsumptions", backwardSubsumed);
   COND_OUT("Fw demodulations to eq. taut.", forwardDemodulationsToEqTaut);
   COND_OUT("Bw demodulations to eq. taut.", backwardDemodulationsToEqTaut);
@@ -348,12 +358,14 @@ void Statistics::print(ostream& out)
   COND_OUT("Disequalities generated from acyclicity",taAcyclicityGeneratedDisequalities);
 
   HEADING("AVATAR",splitClauses+splitComponents+uniqueComponents+satSplits+
-        satSplitRefutations);
+        satSplitRefutations+satSplitModelRepairs+satSplitComponentFlips);
   COND_OUT("Split clauses", splitClauses);
   COND_OUT("Split components", splitComponents);
   COND_OUT("Unique components", uniqueComponents);
   //COND_OUT("Sat splits", satSplits); // same as split clauses
   COND_OUT("Sat splitting refutations", satSplitRefutations);
+  COND_OUT("Sat splitting model repairs", satSplitModelRepairs);
+  COND_OUT("Sat splitting component flips", satSplitComponentFlips);
   COND_OUT("SMT fallbacks",smtFallbacks);
   SEPARATOR;
 
@@ -377,6 +389,8 @@ void Statistics::print(ostream& out)
 
   }
 
+  COND_OUT("Clauses deleted in bulk", deferredDeletedClauses);
+  COND_OUT("Clause memory released in bulk [KB]", deferredDeletedClauseBytes/1024);
   COND_OUT("Memory used [KB]", Allocator::getUsedMemory()/1024);
 
   addCommentSignForSZS(out);
@@ -178,6 +178,8 @@ public:
   unsigned equationalTautologies;
   /** number of forward subsumed clauses */
   unsigned forwardSubsumed;
+  /** number of clauses deleted for being variants of retained clauses */
+  unsigned forwardVariantsEliminated;
   /** number of backward subsumed clauses */
   unsigned backwardSubsumed;
 
@@ -200,7 +202,16 @@ public:
 
   unsigned discardedNonRedundantClauses;
 
+  /** clauses destroyed in bulk by deferred clause deletion */
+  unsigned deferredDeletedClauses;
+  /** bytes of clause objects destroyed in bulk by deferred clause deletion */
+  size_t deferredDeletedClauseBytes;
+
   unsigned inferencesBlockedForOrderingAftercheck;
+  /** comparisons of shared terms looked up in the ordering comparison cache */
+  unsigned long orderingCacheLookups;
+  /** lookups in the ordering comparison cache that found the result */
+  unsigned long orderingCacheHits;
 
   bool smtReturnedUnknown;
   bool smtDidNotEvaluate;
@@ -227,6 +238,10 @@ public:
 
   unsigned satSplits;
   unsigned satSplitRefutations;
+  /** Number of times the AVATAR model was repaired without calling the SAT solver */
+  unsigned satSplitModelRepairs;
+  /** Number of components activated or deactivated by the AVATAR model updates */
+  unsigned satSplitComponentFlips;
 
   unsigned smtFallbacks;
 
@@ -0,0 +1,199 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+
+#include <algorithm>
+
+#include "Lib/Int.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Inference.hpp"
+
+#include "Indexing/ClauseCodeTree.hpp"
+
+#include "Test/UnitTesting.hpp"
+#include "Test/SyntaxSugar.hpp"
+
+#define UNIT_ID clauseCodeTree
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+using namespace Indexing;
+
+/**
+ * Collect into @b res the clauses of @b tree that subsume @b query,
+ * or also those that subsumption-resolve it if @b sres.
+ */
+static void retrieve(ClauseCodeTree& tree, Clause* query, bool sres, Stack<Clause*>& res)
+{
+  res.reset();
+  if (tree.isEmpty()) {
+    return;
+  }
+  static ClauseCodeTree::ClauseMatcher cm;
+  cm.init(&tree, query, sres);
+  int resolvedQueryLit;
+  while (Clause* cl = cm.next(resolvedQueryLit)) {
+    res.push(cl);
+  }
+  cm.deinit();
+  std::sort(res.begin(), res.end());
+  res.truncate(std::unique(res.begin(), res.end()) - res.begin());
+}
+
+static void checkSameResults(ClauseCodeTree& tree, ClauseCodeTree& reference, Stack<Clause*>& queries)
+{
+  static Stack<Clause*> expected;
+  static Stack<Clause*> found;
+  for (unsigned i = 0; i < queries.size(); i++) {
+    for (unsigned sres = 0; sres < 2; sres++) {
+      retrieve(reference, queries[i], sres, expected);
+      retrieve(tree, queries[i], sres, found);
+      ASS_EQ(found.size(), expected.size());
+      for (unsigned j = 0; j < found.size(); j++) {
+        ASS_EQ(found[j], expected[j]);
+      }
+    }
+  }
+}
+
+/**
+ * Build clauses over many predicate and function symbols, so that the
+ * tree compresses their alternatives into SearchStructs, with literals
+ * shared among several clauses.
+ */
+static void buildClauses(Stack<Clause*>& clauses)
+{
+  FOF_SYNTAX_SUGAR
+  THEORY_SYNTAX_SUGAR_FUN(f, 2)
+  THEORY_SYNTAX_SUGAR_PRED(p, 1)
+  THEORY_SYNTAX_SUGAR_PRED(q, 2)
+
+  static Inference inf = NonspecificInference0(UnitInputType::AXIOM, InferenceRule::INPUT);
+
+  static const unsigned SYMBOL_CNT = 10;
+  Stack<TermList> consts;
+  Stack<unsigned> funs;
+  for (unsigned i = 0; i < SYMBOL_CNT; i++) {
+    consts.push(TermWrapper::createConstant(("d" + Int::toString(i)).c_str(), __default_sort));
+    unsigned fn = env.signature->addFunction("k" + Int::toString(i), 1);
+    env.signature->getFunction(fn)->setType(OperatorType::getFunctionType({ __default_sort }, __default_sort));
+    funs.push(fn);
+  }
+
+  Stack<Literal*> lits;
+  for (unsigned i = 0; i < SYMBOL_CNT; i++) {
+    TermList ki_x = TermList(Term::create1(funs[i], x));
+    for (unsigned j = 0; j < SYMBOL_CNT; j += 2) {
+      lits.reset();
+      lits.push(p(ki_x));
+      lits.push(q(consts[j], x));
+      clauses.push(Clause::fromStack(lits, inf));
+
+      lits.reset();
+      lits.push(p(ki_x));
+      lits.push(Literal::complementaryLiteral(q(TermList(Term::create1(funs[j], y)), f(x, y))));
+      clauses.push(Clause::fromStack(lits, inf));
+    }
+    lits.reset();
+    lits.push(p(consts[i]));
+    clauses.push(Clause::fromStack(lits, inf));
+
+    // p(k_i(x)) again, with its variable numbered differently, so that
+    // its LIT_END becomes an alternative of the one above
+    lits.reset();
+    lits.push(q(y, consts[i]));
+    lits.push(q(consts[i], y));
+    lits.push(p(ki_x));
+    clauses.push(Clause::fromStack(lits, inf));
+
+    lits.reset();
+    lits.push(Literal::complementaryLiteral(p(f(consts[i], x))));
+    lits.push(q(x, consts[i]));
+    lits.push(p(ki_x));
+    clauses.push(Clause::fromStack(lits, inf));
+  }
+}
+
+/**
+ * Build query clauses that are subsumed or subsumption-resolved by
+ * some of @b clauses.
+ */
+static void buildQueries(Stack<Clause*>& clauses, Stack<Clause*>& queries)
+{
+  FOF_SYNTAX_SUGAR
+  THEORY_SYNTAX_SUGAR_PRED(r, 1)
+
+  static Inference inf = NonspecificInference0(UnitInputType::AXIOM, InferenceRule::INPUT);
+
+  Stack<Literal*> lits;
+  for (unsigned i = 0; i < clauses.size(); i++) {
+    queries.push(clauses[i]);
+
+    lits.reset();
+    for (unsigned j = 0; j < clauses[i]->length(); j++) {
+      Literal* lit = (*clauses[i])[j];
+      lits.push(j == 0 ? Literal::complementaryLiteral(lit) : lit);
+    }
+    lits.push(r(z));
+    queries.push(Clause::fromStack(lits, inf));
+  }
+}
+
+/**
+ * Remove clauses from a tree by a batch of a single clause, a batch of
+ * a half of them and a batch of all the remaining ones, which leaves
+ * the tree empty, and compare it after each batch with a tree from which
+ * the clauses are removed one by one.
+ */
+TEST_FUN(batchRemovals)
+{
+  Stack<Clause*> clauses;
+  buildClauses(clauses);
+  Stack<Clause*> queries;
+  buildQueries(clauses, queries);
+
+  ClauseCodeTree tree;
+  ClauseCodeTree reference;
+  for (unsigned i = 0; i < clauses.size(); i++) {
+    tree.insert(clauses[i]);
+    reference.insert(clauses[i]);
+  }
+  checkSameResults(tree, reference, queries);
+
+  // every other clause first, so that removals hit the middle of the tree
+  Stack<Clause*> order;
+  for (unsigned i = 0; i < clauses.size(); i += 2) {
+    order.push(clauses[i]);
+  }
+  for (unsigned i = 1; i < clauses.size(); i += 2) {
+    order.push(clauses[i]);
+  }
+  unsigned batchEnds[] = { 1, static_cast<unsigned>(order.size() / 2), static_cast<unsigned>(order.size()) };
+  unsigned removed = 0;
+  Stack<Clause*> batch;
+  for (unsigned b = 0; b < 3; b++) {
+    batch.reset();
+    for (; removed < batchEnds[b]; removed++) {
+      batch.push(order[removed]);
+      reference.remove(order[removed]);
+    }
+    tree.remove(batch);
+    checkSameResults(tree, reference, queries);
+  }
+  ASS(tree.isEmpty());
+
+  // the emptied tree must still accept insertions
+  tree.insert(clauses[0]);
+  reference.insert(clauses[0]);
+  checkSameResults(tree, reference, queries);
+}
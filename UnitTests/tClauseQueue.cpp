@@ -0,0 +1,107 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+
+#include "Lib/Random.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/ClauseQueue.hpp"
+#include "Kernel/Inference.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID clauseQueue
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+
+/** Orders clauses by age, then by input type (larger first) and then by number */
+class TestAgeQueue
+: public ClauseQueue
+{
+public:
+  TestAgeQueue(bool useBuckets) : ClauseQueue(useBuckets) {}
+protected:
+  bool lessThan(Clause* c1, Clause* c2) override
+  {
+    if (c1->age() != c2->age()) {
+      return c1->age() < c2->age();
+    }
+    if (c1->inputType() != c2->inputType()) {
+      return c1->inputType() > c2->inputType();
+    }
+    return c1->number() < c2->number();
+  }
+  unsigned bucketKey(Clause* c) override { return c->age(); }
+  unsigned long long subBucketKey(Clause* c) override
+  { return 255u - static_cast<unsigned>(c->inputType()); }
+};
+
+static void checkSameOrder(ClauseQueue& q1, ClauseQueue& q2)
+{
+  ClauseQueue::Iterator it1(q1);
+  ClauseQueue::Iterator it2(q2);
+  while (it1.hasNext()) {
+    ALWAYS(it2.hasNext());
+    ALWAYS(it1.next() == it2.next());
+  }
+  ASS(!it2.hasNext());
+}
+
+TEST_FUN(bucketsAgreeWithSkipList)
+{
+  static Inference axiom = NonspecificInference0(UnitInputType::AXIOM, InferenceRule::INPUT);
+  static Inference goal = NonspecificInference0(UnitInputType::NEGATED_CONJECTURE, InferenceRule::INPUT);
+
+  TestAgeQueue skipList(false);
+  TestAgeQueue buckets(true);
+  Stack<Clause*> clauses;
+
+  for (unsigned i = 0; i < 500; i++) {
+    Clause* cl = new(0) Clause(0, Random::getBit() ? axiom : goal);
+    // ages above the bucket limit all share the last bucket
+    cl->setAge(i % 50 == 0 ? 100000 + Random::getInteger(100) : Random::getInteger(40));
+    clauses.push(cl);
+    skipList.insert(cl);
+    buckets.insert(cl);
+  }
+  checkSameOrder(skipList, buckets);
+
+  for (unsigned i = 0; i < clauses.size(); i += 3) {
+    ALWAYS(skipList.remove(clauses[i]));
+    ALWAYS(buckets.remove(clauses[i]));
+  }
+  NEVER(buckets.remove(clauses[0]));
+  checkSameOrder(skipList, buckets);
+
+  // clauses inserted again come before newer clauses of their sub-bucket
+  for (unsigned i = 0; i < clauses.size(); i += 6) {
+    skipList.insert(clauses[i]);
+    buckets.insert(clauses[i]);
+  }
+  checkSameOrder(skipList, buckets);
+
+  for (unsigned i = 0; i < 100; i++) {
+    ALWAYS(skipList.pop() == buckets.pop());
+  }
+  checkSameOrder(skipList, buckets);
+
+  while (!skipList.isEmpty()) {
+    ASS(!buckets.isEmpty());
+    ALWAYS(skipList.pop() == buckets.pop());
+  }
+  ASS(buckets.isEmpty());
+
+  while (clauses.isNonEmpty()) {
+    clauses.pop()->destroy();
+  }
+}
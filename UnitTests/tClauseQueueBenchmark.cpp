@@ -0,0 +1,110 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+
+/**
+ * @file tClauseQueueBenchmark.cpp
+ * Timing of the clause queue implementations. Not part of the unit tests,
+ * whose check of the selection order is in tClauseQueue.cpp; build and run
+ * it by make bench-ClauseQueueBenchmark && bin/benchmarks/ClauseQueueBenchmark
+ */
+
+#include <chrono>
+#include <iostream>
+
+#include "Lib/Random.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/ClauseQueue.hpp"
+#include "Kernel/Inference.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID clauseQueueBenchmark
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+
+/** Orders clauses by age and then by number */
+class BenchmarkAgeQueue
+: public ClauseQueue
+{
+public:
+  BenchmarkAgeQueue(bool useBuckets) : ClauseQueue(useBuckets) {}
+protected:
+  bool lessThan(Clause* c1, Clause* c2) override
+  {
+    if (c1->age() != c2->age()) {
+      return c1->age() < c2->age();
+    }
+    return c1->number() < c2->number();
+  }
+  unsigned bucketKey(Clause* c) override { return c->age(); }
+  unsigned long long subBucketKey(Clause*) override { return 0; }
+};
+
+/**
+ * Run a passive-set-like workload on @b q: insert all @b clauses, remove
+ * every other one and pop the rest. Return the elapsed milliseconds and
+ * collect the popped clauses in @b popped.
+ */
+static long runWorkload(ClauseQueue& q, const Stack<Clause*>& clauses, Stack<Clause*>& popped)
+{
+  auto start = chrono::steady_clock::now();
+  for (unsigned i = 0; i < clauses.size(); i++) {
+    q.insert(clauses[i]);
+  }
+  for (unsigned i = 0; i < clauses.size(); i += 2) {
+    ALWAYS(q.remove(clauses[i]));
+  }
+  while (!q.isEmpty()) {
+    popped.push(q.pop());
+  }
+  auto end = chrono::steady_clock::now();
+  return chrono::duration_cast<chrono::milliseconds>(end - start).count();
+}
+
+/**
+ * Compare the skip list with the buckets on many clauses of few ages,
+ * as produced when all children of a given clause get the same age.
+ */
+TEST_FUN(bucketsAgainstSkipList)
+{
+  static Inference inf = NonspecificInference0(UnitInputType::AXIOM, InferenceRule::INPUT);
+  const unsigned clauseCnt = 200000;
+
+  Stack<Clause*> clauses;
+  for (unsigned i = 0; i < clauseCnt; i++) {
+    Clause* cl = new(0) Clause(0, inf);
+    cl->setAge(Random::getInteger(10));
+    clauses.push(cl);
+  }
+
+  BenchmarkAgeQueue skipList(false);
+  BenchmarkAgeQueue buckets(true);
+  Stack<Clause*> skipListPopped;
+  Stack<Clause*> bucketsPopped;
+  long skipListTime = runWorkload(skipList, clauses, skipListPopped);
+  long bucketsTime = runWorkload(buckets, clauses, bucketsPopped);
+
+  cout << clauseCnt << " clauses: skip list " << skipListTime << " ms, buckets "
+       << bucketsTime << " ms" << endl;
+
+  ASS_EQ(skipListPopped.size(), bucketsPopped.size());
+  for (unsigned i = 0; i < skipListPopped.size(); i++) {
+    ALWAYS(skipListPopped[i] == bucketsPopped[i]);
+  }
+
+  while (clauses.isNonEmpty()) {
+    clauses.pop()->destroy();
+  }
+}
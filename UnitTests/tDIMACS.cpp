@@ -0,0 +1,72 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+
+#include "Lib/DArray.hpp"
+
+#include "SAT/DIMACS.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID dimacs
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace SAT;
+
+static SATSolver::Status read(const char* output, unsigned varCnt,
+    DArray<SATSolver::VarAssignment>& assignment)
+{
+  vistringstream in(output);
+  return DIMACS::readSolverOutput(in, varCnt, assignment);
+}
+
+TEST_FUN(satisfiable)
+{
+  DArray<SATSolver::VarAssignment> asgn;
+  ASS_EQ(read("c some comment\ns SATISFIABLE\nv 1 -2\nv 4 0\n", 4, asgn), SATSolver::SATISFIABLE);
+  ASS_EQ(asgn[1], SATSolver::TRUE);
+  ASS_EQ(asgn[2], SATSolver::FALSE);
+  ASS_EQ(asgn[3], SATSolver::DONT_CARE);
+  ASS_EQ(asgn[4], SATSolver::TRUE);
+}
+
+TEST_FUN(unsatisfiable)
+{
+  DArray<SATSolver::VarAssignment> asgn;
+  ASS_EQ(read("c some comment\ns UNSATISFIABLE\n", 3, asgn), SATSolver::UNSATISFIABLE);
+}
+
+TEST_FUN(unknown)
+{
+  DArray<SATSolver::VarAssignment> asgn;
+  ASS_EQ(read("s UNKNOWN\n", 3, asgn), SATSolver::UNKNOWN);
+  // no status line, e.g. when the solver crashed
+  ASS_EQ(read("", 3, asgn), SATSolver::UNKNOWN);
+  ASS_EQ(read("c interrupted\n", 3, asgn), SATSolver::UNKNOWN);
+}
+
+TEST_FUN(malformed)
+{
+  DArray<SATSolver::VarAssignment> asgn;
+  // unknown status
+  ASS_EQ(read("s SATISFIABLE-ISH\nv 1 0\n", 3, asgn), SATSolver::UNKNOWN);
+  ASS_EQ(read("s SATISFIABLE maybe\nv 1 0\n", 3, asgn), SATSolver::UNKNOWN);
+  // contradicting status lines
+  ASS_EQ(read("s SATISFIABLE\ns UNSATISFIABLE\nv 1 0\n", 3, asgn), SATSolver::UNKNOWN);
+  // a token that is not a literal
+  ASS_EQ(read("s SATISFIABLE\nv 1 x 0\n", 3, asgn), SATSolver::UNKNOWN);
+  // a variable that is not in the problem
+  ASS_EQ(read("s SATISFIABLE\nv 1 -7 0\n", 3, asgn), SATSolver::UNKNOWN);
+  // a model that is not terminated
+  ASS_EQ(read("s SATISFIABLE\nv 1 -2\n", 3, asgn), SATSolver::UNKNOWN);
+  // literals after the terminating 0
+  ASS_EQ(read("s SATISFIABLE\nv 1 0 2\n", 3, asgn), SATSolver::UNKNOWN);
+}
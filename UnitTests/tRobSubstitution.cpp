@@ -0,0 +1,159 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+
+#include <climits>
+
+#include "Lib/Backtrackable.hpp"
+
+#include "Kernel/RobSubstitution.hpp"
+
+#include "Test/UnitTesting.hpp"
+#include "Test/SyntaxSugar.hpp"
+
+#define UNIT_ID robSubstitution
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+
+TEST_FUN(nestedRecording)
+{
+  FOF_SYNTAX_SUGAR
+  THEORY_SYNTAX_SUGAR_FUN(f, 2)
+  THEORY_SYNTAX_SUGAR_FUN(g, 1)
+  THEORY_SYNTAX_SUGAR_CONST(a)
+  THEORY_SYNTAX_SUGAR_CONST(b)
+
+  RobSubstitution subst;
+
+  BacktrackData outer;
+  subst.bdRecord(outer);
+  ALWAYS(subst.unify(x, 0, g(a), 1));
+
+  BacktrackData inner;
+  subst.bdRecord(inner);
+  ALWAYS(subst.unify(f(y, x), 0, f(b, z), 1));
+  subst.bdDone();
+  ASS(!inner.isEmpty());
+  ASS_EQ(subst.apply(f(x, y), 0), TermList(f(g(a), b)));
+  ASS_EQ(subst.apply(z, 1), TermList(g(a)));
+
+  inner.backtrack();
+  ASS(subst.isUnbound(1, 0));
+  ASS(subst.isUnbound(2, 1));
+  ASS_EQ(subst.apply(x, 0), TermList(g(a)));
+
+  // bindings committed from an inner record are undone with the outer one
+  subst.bdRecord(inner);
+  ALWAYS(subst.unify(y, 0, a, 1));
+  subst.bdDone();
+  subst.bdCommit(inner);
+  ASS(inner.isEmpty());
+  ASS_EQ(subst.apply(y, 0), TermList(a));
+
+  subst.bdDone();
+  outer.backtrack();
+  ASS(subst.isUnbound(0, 0));
+  ASS(subst.isUnbound(1, 0));
+  ASS_EQ(subst.size(), 0u);
+}
+
+TEST_FUN(failedUnificationIsUndone)
+{
+  FOF_SYNTAX_SUGAR
+  THEORY_SYNTAX_SUGAR_FUN(f, 2)
+  THEORY_SYNTAX_SUGAR_CONST(a)
+  THEORY_SYNTAX_SUGAR_CONST(b)
+
+  RobSubstitution subst;
+  ALWAYS(subst.unify(z, 0, b, 0));
+
+  // x, y and z of the second bank get bound before a and b clash
+  NEVER(subst.unify(f(x, f(y, a)), 0, f(z, f(f(x, z), b)), 1));
+  ASS(subst.isUnbound(0, 0));
+  ASS(subst.isUnbound(1, 0));
+  ASS(subst.isUnbound(2, 1));
+  ASS_EQ(subst.apply(z, 0), TermList(b));
+  ASS_EQ(subst.size(), 1u);
+
+  // the same while recording, which must not leave anything to backtrack
+  BacktrackData bd;
+  subst.bdRecord(bd);
+  NEVER(subst.unify(f(x, f(y, a)), 0, f(z, f(f(x, z), b)), 1));
+  subst.bdDone();
+  ASS(bd.isEmpty());
+  ASS(subst.isUnbound(0, 0));
+  ASS(subst.isUnbound(1, 0));
+  ASS_EQ(subst.size(), 1u);
+
+  // the occurs check fails after x is bound
+  NEVER(subst.unify(f(x, x), 0, f(y, f(y, a)), 0));
+  ASS(subst.isUnbound(0, 0));
+  ASS(subst.isUnbound(1, 0));
+  ASS_EQ(subst.size(), 1u);
+}
+
+TEST_FUN(failedMatchIsUndone)
+{
+  FOF_SYNTAX_SUGAR
+  THEORY_SYNTAX_SUGAR_FUN(f, 2)
+  THEORY_SYNTAX_SUGAR_CONST(a)
+  THEORY_SYNTAX_SUGAR_CONST(b)
+
+  RobSubstitution subst;
+
+  // x is bound to a before it fails to match b
+  NEVER(subst.match(f(x, f(y, x)), 0, f(a, f(b, b)), 1));
+  ASS(subst.isUnbound(0, 0));
+  ASS(subst.isUnbound(1, 0));
+  ASS_EQ(subst.size(), 0u);
+
+  BacktrackData bd;
+  subst.bdRecord(bd);
+  ALWAYS(subst.match(f(x, y), 0, f(a, b), 1));
+  NEVER(subst.match(f(z, x), 0, f(b, b), 1));
+  subst.bdDone();
+  ASS(subst.isUnbound(2, 0));
+  ASS_EQ(subst.apply(f(x, y), 0), TermList(f(a, b)));
+
+  bd.backtrack();
+  ASS_EQ(subst.size(), 0u);
+}
+
+#if VDEBUG
+TEST_FUN(resetWrapsStampsAround)
+{
+  FOF_SYNTAX_SUGAR
+  THEORY_SYNTAX_SUGAR_CONST(a)
+  THEORY_SYNTAX_SUGAR_CONST(b)
+
+  RobSubstitution subst;
+  // bound with the stamp 1, which becomes current again after the wrap
+  ALWAYS(subst.unify(x, 0, a, 1));
+  subst.reset();
+  ASS(subst.isUnbound(0, 0));
+
+  subst.setStamp(UINT_MAX);
+  ALWAYS(subst.unify(y, 0, b, 1));
+  ASS(subst.isUnbound(0, 0));
+  ASS_EQ(subst.apply(y, 0), TermList(b));
+
+  subst.reset();
+  ASS(subst.isUnbound(0, 0));
+  ASS(subst.isUnbound(1, 0));
+  ASS_EQ(subst.size(), 0u);
+
+  ALWAYS(subst.unify(x, 0, b, 1));
+  ASS_EQ(subst.apply(x, 0), TermList(b));
+  subst.reset();
+  ASS_EQ(subst.size(), 0u);
+}
+#endif
@@ -0,0 +1,259 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+
+#include "Lib/Int.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Indexing/CodeTreeInterfaces.hpp"
+#include "Indexing/DiscriminationTree.hpp"
+#include "Indexing/FingerprintIndex.hpp"
+#include "Indexing/TermSubstitutionTree.hpp"
+
+#include "Test/UnitTesting.hpp"
+#include "Test/SyntaxSugar.hpp"
+
+#define UNIT_ID termIndexingStructures
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+using namespace Indexing;
+
+enum Retrieval { GENERALIZATIONS, INSTANCES, UNIFICATIONS };
+
+static TermQueryResultIterator retrieve(TermIndexingStructure& is, Retrieval r, TermList query)
+{
+  switch (r) {
+  case GENERALIZATIONS:
+    return is.getGeneralizations(query, true);
+  case INSTANCES:
+    return is.getInstances(query, false);
+  case UNIFICATIONS:
+    return is.getUnifications(query, false);
+  }
+  ASSERTION_VIOLATION;
+}
+
+/**
+ * Check that both structures retrieve the same terms for @b query and
+ * that the substitutions of generalizations turn them into the query.
+ */
+static void checkSameResults(TermIndexingStructure& tree, TermIndexingStructure& reference,
+    Retrieval r, TermList query)
+{
+  Stack<TermList> expected;
+  TermQueryResultIterator rit = retrieve(reference, r, query);
+  while (rit.hasNext()) {
+    expected.push(rit.next().term);
+  }
+
+  unsigned found = 0;
+  TermQueryResultIterator tit = retrieve(tree, r, query);
+  while (tit.hasNext()) {
+    TermQueryResult qr = tit.next();
+    ASS(expected.find(qr.term));
+    if (r == GENERALIZATIONS && qr.substitution->isIdentityOnQueryWhenResultBound()) {
+      ASS_EQ(qr.substitution->applyToBoundResult(qr.term), query);
+    }
+    found++;
+  }
+  ASS_EQ(found, expected.size());
+  if (r == GENERALIZATIONS) {
+    ASS_EQ(tree.generalizationExists(query), found > 0);
+  }
+}
+
+static void checkAllQueries(TermIndexingStructure& tree, TermIndexingStructure& reference,
+    Stack<TermList>& queries)
+{
+  for (unsigned i = 0; i < queries.size(); i++) {
+    checkSameResults(tree, reference, GENERALIZATIONS, queries[i]);
+    checkSameResults(tree, reference, INSTANCES, queries[i]);
+    checkSameResults(tree, reference, UNIFICATIONS, queries[i]);
+  }
+}
+
+/**
+ * Check that @b tree retrieves the same terms from @b terms as
+ * a substitution tree, also after some of them are removed.
+ */
+static void checkAgainstSubstitutionTree(TermIndexingStructure& tree, Stack<TermList>& terms)
+{
+  TermSubstitutionTree reference;
+  for (unsigned i = 0; i < terms.size(); i++) {
+    tree.insert(terms[i], 0, 0);
+    reference.insert(terms[i], 0, 0);
+  }
+  checkAllQueries(tree, reference, terms);
+
+  for (unsigned i = 0; i < terms.size(); i += 2) {
+    tree.remove(terms[i], 0, 0);
+    reference.remove(terms[i], 0, 0);
+  }
+  checkAllQueries(tree, reference, terms);
+}
+
+/**
+ * Check that @b tree retrieves the same generalizations of @b queries (or
+ * also instances and unifications if @b allRetrievals) as @b reference.
+ */
+static void checkQueries(TermIndexingStructure& tree, TermIndexingStructure& reference,
+    Stack<TermList>& queries, bool allRetrievals)
+{
+  if (allRetrievals) {
+    checkAllQueries(tree, reference, queries);
+    return;
+  }
+  for (unsigned i = 0; i < queries.size(); i++) {
+    checkSameResults(tree, reference, GENERALIZATIONS, queries[i]);
+  }
+}
+
+/**
+ * Insert @b terms into @b tree in one batch and then remove them by
+ * a batch of a single term, a batch of a half of them and a batch of all
+ * the remaining ones, which leaves the tree empty. After each batch, check
+ * that @b tree retrieves the same terms as a substitution tree updated one
+ * by one.
+ */
+static void checkBatchesAgainstSubstitutionTree(TermIndexingStructure& tree, Stack<TermList>& terms,
+    bool allRetrievals)
+{
+  TermSubstitutionTree reference;
+  tree.startBatch(true);
+  for (unsigned i = 0; i < terms.size(); i++) {
+    tree.insert(terms[i], 0, 0);
+    reference.insert(terms[i], 0, 0);
+  }
+  tree.finishBatch();
+  checkQueries(tree, reference, terms, allRetrievals);
+
+  // every other term first, so that removals hit the middle of the tree
+  Stack<TermList> order;
+  for (unsigned i = 0; i < terms.size(); i += 2) {
+    order.push(terms[i]);
+  }
+  for (unsigned i = 1; i < terms.size(); i += 2) {
+    order.push(terms[i]);
+  }
+  unsigned batchEnds[] = { 1, static_cast<unsigned>(order.size() / 2), static_cast<unsigned>(order.size()) };
+  unsigned removed = 0;
+  for (unsigned b = 0; b < 3; b++) {
+    tree.startBatch(false);
+    for (; removed < batchEnds[b]; removed++) {
+      tree.remove(order[removed], 0, 0);
+      reference.remove(order[removed], 0, 0);
+    }
+    tree.finishBatch();
+    checkQueries(tree, reference, terms, allRetrievals);
+  }
+
+  // the emptied tree must still accept insertions
+  tree.startBatch(true);
+  tree.insert(terms[0], 0, 0);
+  reference.insert(terms[0], 0, 0);
+  tree.finishBatch();
+  checkQueries(tree, reference, terms, allRetrievals);
+}
+
+static void buildTerms(Stack<TermList>& terms)
+{
+  FOF_SYNTAX_SUGAR
+  THEORY_SYNTAX_SUGAR_FUN(f, 2)
+  THEORY_SYNTAX_SUGAR_FUN(g, 1)
+  THEORY_SYNTAX_SUGAR_CONST(a)
+  THEORY_SYNTAX_SUGAR_CONST(b)
+
+  Stack<TermList> leaves;
+  leaves.push(a);
+  leaves.push(b);
+  leaves.push(x);
+  leaves.push(y);
+
+  for (unsigned i = 0; i < leaves.size(); i++) {
+    terms.push(leaves[i]);
+    terms.push(g(leaves[i]));
+    for (unsigned j = 0; j < leaves.size(); j++) {
+      terms.push(f(leaves[i], leaves[j]));
+    }
+  }
+  terms.push(g(f(x, a)));
+  terms.push(f(g(x), x));
+  terms.push(f(f(x, y), g(y)));
+  terms.push(f(f(y, x), g(y)));
+  terms.push(f(g(a), f(x, x)));
+  terms.push(f(z, g(z)));
+}
+
+/**
+ * Add terms with many distinct function symbols and ground subterms
+ * at the same positions to @b terms, so that code trees compress their
+ * alternatives into SearchStructs.
+ */
+static void buildManySymbolTerms(Stack<TermList>& terms)
+{
+  FOF_SYNTAX_SUGAR
+  THEORY_SYNTAX_SUGAR_FUN(f, 2)
+
+  static const unsigned SYMBOL_CNT = 12;
+  Stack<TermList> consts;
+  Stack<unsigned> funs;
+  for (unsigned i = 0; i < SYMBOL_CNT; i++) {
+    consts.push(TermWrapper::createConstant(("c" + Int::toString(i)).c_str(), __default_sort));
+    unsigned fn = env.signature->addFunction("h" + Int::toString(i), 1);
+    env.signature->getFunction(fn)->setType(OperatorType::getFunctionType({ __default_sort }, __default_sort));
+    funs.push(fn);
+  }
+
+  for (unsigned i = 0; i < SYMBOL_CNT; i++) {
+    terms.push(consts[i]);
+    terms.push(TermList(Term::create1(funs[i], x)));
+    for (unsigned j = 0; j < SYMBOL_CNT; j += 3) {
+      terms.push(TermList(Term::create1(funs[i], consts[j])));
+      terms.push(f(consts[i], TermList(Term::create1(funs[j], y))));
+    }
+    terms.push(f(x, consts[i]));
+  }
+  terms.push(x);
+}
+
+TEST_FUN(agreeWithSubstitutionTree)
+{
+  Stack<TermList> terms;
+  buildTerms(terms);
+
+  DiscriminationTree discriminationTree;
+  checkAgainstSubstitutionTree(discriminationTree, terms);
+  FingerprintIndex fingerprintIndex;
+  checkAgainstSubstitutionTree(fingerprintIndex, terms);
+}
+
+TEST_FUN(batchedUpdates)
+{
+  Stack<TermList> terms;
+  buildTerms(terms);
+
+  TermSubstitutionTree substitutionTree;
+  checkBatchesAgainstSubstitutionTree(substitutionTree, terms, true);
+  CodeTreeTIS codeTree;
+  checkBatchesAgainstSubstitutionTree(codeTree, terms, false);
+}
+
+TEST_FUN(batchedUpdatesWithManySymbols)
+{
+  Stack<TermList> terms;
+  buildManySymbolTerms(terms);
+
+  TermSubstitutionTree substitutionTree;
+  checkBatchesAgainstSubstitutionTree(substitutionTree, terms, true);
+  CodeTreeTIS codeTree;
+  checkBatchesAgainstSubstitutionTree(codeTree, terms, false);
+}
@@ -0,0 +1,7 @@
+% params: -sa fmb -fmbes contour -fmbi on
+% grep: | X = fmb_.i_5$
+
+% orbits of s have 5 elements, the model is found after 4 size increases
+
+fof(a,axiom, ![X]: s(s(s(s(s(X)))))=X).
+fof(b,axiom, ![X]: s(X)!=X).
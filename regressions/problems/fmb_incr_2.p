@@ -0,0 +1,7 @@
+% params: -sa fmb -fmbes contour -fmbi off
+% grep: | X = fmb_.i_5$
+
+% the same as fmb_incr_1.p without the incremental encoding
+
+fof(a,axiom, ![X]: s(s(s(s(s(X)))))=X).
+fof(b,axiom, ![X]: s(X)!=X).
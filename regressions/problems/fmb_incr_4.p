@@ -0,0 +1,14 @@
+% params: -sa fmb -fmbes contour -fmbi off
+% grep: | X = fmb_u_4$
+
+% the same as fmb_incr_3.p without the incremental encoding
+
+tff(u,type, u: $tType).
+tff(w,type, w: $tType).
+tff(s,type, s: u > u).
+tff(g,type, g: w > u).
+tff(h,type, h: u > w).
+tff(a,axiom, ![X:u]: s(s(s(s(X))))=X).
+tff(b,axiom, ![X:u]: s(s(X))!=X).
+tff(c,axiom, ![X:w]: h(g(X))=X).
+tff(d,axiom, ?[X:w,Y:w,Z:w]: (X!=Y & Y!=Z & X!=Z)).
@@ -0,0 +1,9 @@
+% params: -sa fmb -fmbes contour -fmbi on
+% res: unsat
+
+% p cannot alternate along the odd orbits of s, refuted after 2 size increases
+
+fof(a,axiom, ![X]: s(s(s(X)))=X).
+fof(b,axiom, ![X]: s(X)!=X).
+fof(c,axiom, ![X]: (p(X) <=> ~p(s(X)))).
+fof(d,axiom, ![X]: (X=a | X=b | X=c | X=d | X=e)).